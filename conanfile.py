@@ -97,6 +97,8 @@ class LibConan(ConanFile):
         lib_dir = '%s' % self.settings.build_type
         self.cpp_info.libdirs = [lib_dir]
         self.cpp_info.libs = tools.collect_libs(self, lib_dir)
+        if self.settings.os == "Linux":
+            self.cpp_info.libs.append("pthread")
 
 # ----------------------------------------------------------------------------------#
 # //////////////////////////////////////////////////////////////////////////////////#
@@ -105,6 +105,11 @@ public:
      */
     bool parity() const;
 
+    /*!
+     * \details Checks whether the matrix is identity, transforming by such a matrix changes nothing.
+     */
+    bool isIdentity() const;
+
     /*!
      * \deprecated use \link TMatrix::parity \endlink
      */
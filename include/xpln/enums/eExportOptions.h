@@ -95,6 +95,45 @@ enum eExportOptions : std::uint64_t {
      */
     XOBJ_EXP_DEBUG = 1 << 24,
 
+    /*!
+     * \details Reordering the mesh triangles for the GPU post-transform vertex cache
+     * and renumbering the vertices in the first use order.
+     * The triangles stay in the ranges of their meshes.
+     * \note The vertex cache misses ratio is reported by the export statistic.
+     */
+    XOBJ_EXP_OPTIMIZE_VERTEX_CACHE = 1 << 25,
+
+    /*!
+     * \details Reordering the meshes inside the LODs, the draped geometry and the animations
+     * to minimize the attributes changes.
+     * The blended meshes keep their drawing order, the objects aren't moved across the animation.
+     * \note The count of the attributes which weren't printed thanks to it is reported by the export statistic.
+     */
+    XOBJ_EXP_REORDER_BY_ATTRIBUTES = 1 << 26,
+
+    /*!
+     * \details Printing the consecutive meshes with the same attributes and the consecutive light points
+     * by one TRIS or LIGHTS command when their geometry ranges are contiguous and they haven't the custom data lines.
+     * \note The merged meshes are imported as one mesh. The objects marked by the names aren't merged.
+     */
+    XOBJ_EXP_COALESCE_RANGES = 1 << 27,
+
+    /*!
+     * \details Removing the translation and rotation animation keys which can be interpolated
+     * from the neighbour ones with the error in the tolerance (see ExportContext::setKeyframesTolerance).
+     * The animations whose keys are all zero are not printed.
+     * \note The count of the removed keys is reported by the export statistic.
+     */
+    XOBJ_EXP_REDUCE_KEYFRAMES = 1 << 28,
+
+    /*!
+     * \details Merging the LODs with the identical geometry, attributes and animation
+     * whose distance bands are adjacent into one LOD (see LodsAlg::mergeIdenticalLods)
+     * and printing the identical meshes by the same IDX range when \link XOBJ_EXP_OPTIMIZATION \endlink is enabled.
+     * \note The merged LODs are removed from the ObjMain, so the references to them become invalid.
+     */
+    XOBJ_EXP_MERGE_IDENTICAL_GEOMETRY = 1 << 29,
+
 };
 
 /**************************************************************************************************/
@@ -31,8 +31,15 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+#include <unordered_set>
+#include <ostream>
+#include <functional>
+#include <cstddef>
 #include "xpln/Export.h"
 #include "xpln/utils/Path.h"
+#include "xpln/utils/DatarefRegistry.h"
+#include "xpln/utils/CommandRegistry.h"
 #include "xpln/common/IInterrupter.h"
 #include "IOStatistic.h"
 
@@ -48,6 +55,16 @@ public:
     //-------------------------------------------------------------------------
     /// @{
 
+    /*!
+     * \details Receives a chunk of the obj content.
+     * \return False for stopping the export with the error.
+     */
+    typedef std::function<bool(const char * data, std::size_t size)> OutputCallback;
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// @{
+
     ExportContext() = default;
 
     /*! \see \link ExportContext::setObjFile \endlink */
@@ -118,6 +135,181 @@ public:
     /*! \see \link ExportContext::setCommandsFile \endlink */
     const Path & commandsFile() const { return mCommandsFile; }
 
+    /*!
+     * \details Sets the loaded datarefs that are used instead of the datarefs file.
+     *          The registry can be shared between any number of contexts,
+     *          so the datarefs file is parsed only once for many objects.
+     *          If the registry isn't set then the datarefs file is loaded
+     *          through \link DatarefRegistry::cached \endlink.
+     * \param [in] registry
+     */
+    void setDatarefRegistry(DatarefRegistry::Ptr registry) { mDatarefRegistry = std::move(registry); }
+
+    /*!
+     * \details Sets the loaded commands that are used instead of the commands file.
+     * \see \link ExportContext::setDatarefRegistry \endlink
+     * \param [in] registry
+     */
+    void setCommandRegistry(CommandRegistry::Ptr registry) { mCommandRegistry = std::move(registry); }
+
+    /*! \see \link ExportContext::setDatarefRegistry \endlink */
+    const DatarefRegistry::Ptr & datarefRegistry() const { return mDatarefRegistry; }
+
+    /*! \see \link ExportContext::setCommandRegistry \endlink */
+    const CommandRegistry::Ptr & commandRegistry() const { return mCommandRegistry; }
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// \name Output
+    /// @{
+
+    /*!
+     * \details Size of the buffer that is used for writing the obj file.
+     *          The lines are collected in the buffer and written to the file by blocks of this size.
+     *          Default value is 1 MiB.
+     * \param [in] bytes 0 means each line is written to the file immediately.
+     */
+    void setOutputBufferSize(const std::size_t bytes) { mOutputBufferSize = bytes; }
+
+    /*!
+     * \details If it is enabled then the output buffer size is calculated
+     *          from the object's vertices and indices count (POINT_COUNTS),
+     *          so usually the whole file is written by one block.
+     *          The value of \link ExportContext::setOutputBufferSize \endlink is used as the minimum.
+     * \note The whole file content is kept in memory until the writing is finished.
+     * \param [in] state
+     */
+    void setPreSizedOutputBuffer(const bool state) { mPreSizedOutputBuffer = state; }
+
+    /*! \see \link ExportContext::setOutputBufferSize \endlink */
+    std::size_t outputBufferSize() const { return mOutputBufferSize; }
+
+    /*! \see \link ExportContext::setPreSizedOutputBuffer \endlink */
+    bool isPreSizedOutputBuffer() const { return mPreSizedOutputBuffer; }
+
+    /*!
+     * \details Threads count for formatting the vertices (VT, VLINE, VLIGHT).
+     *          The result doesn't depend on the threads count.
+     *          Default value is 1, it means the vertices are formatted by the calling thread.
+     * \param [in] threads 0 means hardware concurrency.
+     */
+    void setWorkerThreads(const std::size_t threads) { mWorkerThreads = threads; }
+
+    /*! \see \link ExportContext::setWorkerThreads \endlink */
+    std::size_t workerThreads() const { return mWorkerThreads; }
+
+    /*!
+     * \details Sets the callback that receives the obj content by chunks instead of writing it to the file.
+     *          The chunk size is about \link ExportContext::setOutputBufferSize \endlink.
+     * \note If the output is set then the obj file path isn't used.
+     * \note If the export fails then the buffered data isn't passed to the output,
+     *       but the chunks that were passed before the failure aren't revoked.
+     *       So the output gets nothing only if the whole object fits into the buffer
+     *       or the export fails before printing (validation, references).
+     *       The same is for the stream, string and vector outputs.
+     * \param [in] callback
+     */
+    void setOutputCallback(OutputCallback callback) { mOutput = std::move(callback); }
+
+    /*!
+     * \details Sets the stream that receives the obj content instead of the file.
+     * \note The stream must be alive until the export is finished.
+     * \note If the output is set then the obj file path isn't used.
+     * \param [in, out] stream
+     */
+    void setOutputStream(std::ostream & stream) {
+        std::ostream * out = &stream;
+        mOutput = [out](const char * data, const std::size_t size) {
+            return static_cast<bool>(out->write(data, static_cast<std::streamsize>(size)));
+        };
+    }
+
+    /*!
+     * \details Sets the string that receives the obj content instead of the file.
+     *          The content is appended to the string.
+     * \note The string must be alive until the export is finished.
+     * \note If the output is set then the obj file path isn't used.
+     * \param [in, out] str
+     */
+    void setOutputString(std::string & str) {
+        std::string * out = &str;
+        mOutput = [out](const char * data, const std::size_t size) {
+            out->append(data, size);
+            return true;
+        };
+    }
+
+    /*!
+     * \details Sets the vector that receives the obj content instead of the file.
+     *          The content is appended to the vector.
+     * \note The vector must be alive until the export is finished.
+     * \note If the output is set then the obj file path isn't used.
+     * \param [in, out] vec
+     */
+    void setOutputVector(std::vector<char> & vec) {
+        std::vector<char> * out = &vec;
+        mOutput = [out](const char * data, const std::size_t size) {
+            out->insert(out->end(), data, data + size);
+            return true;
+        };
+    }
+
+    /*!
+     * \details Removes the output that was set, so the obj file is used again.
+     */
+    void resetOutput() { mOutput = nullptr; }
+
+    /*!
+     * \return Output callback or empty function if the obj file is used.
+     */
+    const OutputCallback & outputCallback() const { return mOutput; }
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// \name Optimization
+    /// @{
+
+    /*!
+     * \details Max error of the animation keys simplification,
+     *          see \link eExportOptions::XOBJ_EXP_REDUCE_KEYFRAMES \endlink.
+     *          Default values are 0.001 for the position and 0.01 degree for the angle.
+     * \param [in] position max distance in the position units for the translation keys.
+     * \param [in] degrees max angle difference in degrees for the rotation keys.
+     */
+    void setKeyframesTolerance(const float position, const float degrees) {
+        mKeyframesPositionTolerance = position;
+        mKeyframesAngleTolerance = degrees;
+    }
+
+    /*! \see \link ExportContext::setKeyframesTolerance \endlink */
+    float keyframesPositionTolerance() const { return mKeyframesPositionTolerance; }
+
+    /*! \see \link ExportContext::setKeyframesTolerance \endlink */
+    float keyframesAngleTolerance() const { return mKeyframesAngleTolerance; }
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// \name Result
+    /// @{
+
+    /*!
+     * \details The datarefs which are printed to the exported object.
+     *          The ids are already resolved to the actual datarefs.
+     *          It is filled by the export before printing the object.
+     */
+    const std::unordered_set<std::string> & usedDatarefs() const { return mUsedDatarefs; }
+
+    /*!
+     * \details The commands which are printed to the exported object.
+     * \see \link ExportContext::usedDatarefs \endlink
+     */
+    const std::unordered_set<std::string> & usedCommands() const { return mUsedCommands; }
+
+    void setUsedReferences(const std::unordered_set<std::string> & datarefs, const std::unordered_set<std::string> & commands) {
+        mUsedDatarefs = datarefs;
+        mUsedCommands = commands;
+    }
+
     /// @}
     //-------------------------------------------------------------------------
 
@@ -126,7 +318,17 @@ private:
     Path mObjFile;
     Path mDatarefsFile;
     Path mCommandsFile;
+    DatarefRegistry::Ptr mDatarefRegistry;
+    CommandRegistry::Ptr mCommandRegistry;
     std::string mSignature;
+    std::size_t mOutputBufferSize = 1024 * 1024;
+    bool mPreSizedOutputBuffer = false;
+    std::size_t mWorkerThreads = 1;
+    float mKeyframesPositionTolerance = 0.001f;
+    float mKeyframesAngleTolerance = 0.01f;
+    OutputCallback mOutput;
+    std::unordered_set<std::string> mUsedDatarefs;
+    std::unordered_set<std::string> mUsedCommands;
     IOStatistic mStatistic;
     std::unique_ptr<IInterrupter> mInterruptor;
 
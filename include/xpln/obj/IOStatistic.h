@@ -41,6 +41,14 @@ class ObjWriter;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
 
+/*!
+ * \details Duration of one phase of the 'obj' Reader/Writer.
+ */
+struct IOPhaseTime {
+    double pWallSec = 0.0; //!< Wall-clock time in seconds.
+    double pCpuSec = 0.0;  //!< CPU time of the process in seconds, it includes all the threads.
+};
+
 /*!
  * \details Statistic of the 'obj' Reader/Writer.
  */
@@ -73,6 +81,92 @@ public:
 
     std::size_t pAnimAttrCount;
 
+    std::size_t pOptWeldedVerticesCount;  //!< Mesh vertices welded with the identical ones by the export optimization
+    std::size_t pOptUnusedVerticesCount;  //!< Mesh vertices unused by any face and removed by the export optimization
+    std::size_t pOptDegenerateFacesCount; //!< Degenerate faces removed by the export optimization
+
+    /*!
+     * \details Average vertex cache misses per triangle before and after the vertex cache optimization,
+     *          see \link eExportOptions::XOBJ_EXP_OPTIMIZE_VERTEX_CACHE \endlink.
+     */
+    float pOptAcmrBefore;
+    float pOptAcmrAfter; //!< \copydoc pOptAcmrBefore
+
+    /*!
+     * \details Decrease of the pTrisAttrCount thanks to the objects reordering,
+     *          see \link eExportOptions::XOBJ_EXP_REORDER_BY_ATTRIBUTES \endlink.
+     */
+    std::size_t pOptTrisAttrAvoidedCount;
+
+    /*!
+     * \details Mesh and light point objects printed by the TRIS or LIGHTS command of the previous object
+     *          because they have the same attributes and the contiguous geometry,
+     *          see \link eExportOptions::XOBJ_EXP_COALESCE_RANGES \endlink.
+     */
+    std::size_t pOptCoalescedObjCount;
+
+    /*!
+     * \details Animations without objects which weren't printed,
+     *          see \link eExportOptions::XOBJ_EXP_OPTIMIZATION \endlink.
+     */
+    std::size_t pOptEmptyAnimCount;
+
+    /*!
+     * \details Animation keys removed by the keys simplification,
+     *          see \link eExportOptions::XOBJ_EXP_REDUCE_KEYFRAMES \endlink.
+     */
+    std::size_t pOptTransKeysRemovedCount;
+    std::size_t pOptRotateKeysRemovedCount; //!< \copydoc pOptTransKeysRemovedCount
+    std::size_t pOptAnimRemovedCount;       //!< Animations with all zero keys which weren't printed.
+
+    /*!
+     * \details LODs merged into the identical LOD with the adjacent distance band.
+     */
+    std::size_t pOptMergedLodsCount;
+
+    /*!
+     * \details Faces whose IDX range isn't printed because an identical mesh already uses the same range,
+     *          see \link eExportOptions::XOBJ_EXP_OPTIMIZATION \endlink.
+     */
+    std::size_t pOptSharedFacesCount;
+
+    //------------------------------------------------------------
+    /// \name Export phases
+    /// @{
+
+    IOPhaseTime pTimeLodsValidation; //!< LODs validation, merging and sorting.
+    IOPhaseTime pTimeInstancing;     //!< InstancingAlg, see \link eExportOptions::XOBJ_EXP_CHECK_INSTANCE \endlink.
+    IOPhaseTime pTimePreparing;      //!< Objects preparing (ObjWritePreparer).
+    IOPhaseTime pTimeTransformation; //!< Applying the export transformation to the objects.
+    IOPhaseTime pTimeCounting;       //!< Building the export plan with its optimizations.
+    IOPhaseTime pTimeVertices;       //!< Printing the VT, VLINE and VLIGHT sections.
+    IOPhaseTime pTimeIndices;        //!< Printing the IDX section.
+    IOPhaseTime pTimeObjects;        //!< Printing the attributes, animations and objects.
+
+    /// @}
+    //------------------------------------------------------------
+    /// \name Import phases
+    /// @{
+
+    IOPhaseTime pTimeFileLoad;       //!< Reading the file into the memory.
+    IOPhaseTime pTimeHeader;         //!< Parsing the header, the global attributes and the counts.
+    IOPhaseTime pTimeGeometry;       //!< Parsing the VT and IDX sections.
+    IOPhaseTime pTimeInterpretation; //!< Parsing the commands and making the objects.
+
+    /// @}
+    //------------------------------------------------------------
+
+    IOPhaseTime pTimeTotal; //!< Whole export or import time.
+
+    std::size_t pBytesWritten; //!< Bytes written to the file or to the output.
+    std::size_t pBytesRead;    //!< Bytes read from the file.
+
+    /*!
+     * \details The biggest temporary buffer: the output buffer or the parallel formatting blocks for the export
+     *          and the file content for the import.
+     */
+    std::size_t pPeakBufferBytes;
+
     //------------------------------------------------------------
 
     XpObjLib void reset();
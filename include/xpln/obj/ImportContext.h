@@ -29,6 +29,7 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include "xpln/Export.h"
@@ -117,6 +118,36 @@ public:
 
     /// @}
     //-------------------------------------------------------------------------
+    /// \name Input
+    /// @{
+
+    /*!
+     * \details Threads count for parsing the vertices and the indices (VT, IDX, IDX10).
+     *          The geometry section is split by lines into chunks which are parsed in parallel,
+     *          the result doesn't depend on the threads count.
+     *          Default value is 1, it means the geometry is parsed by the calling thread.
+     * \param [in] threads 0 means hardware concurrency.
+     */
+    void setWorkerThreads(const std::size_t threads) { mWorkerThreads = threads; }
+
+    /*! \see \link ImportContext::setWorkerThreads \endlink */
+    std::size_t workerThreads() const { return mWorkerThreads; }
+
+    /*!
+     * \details Makes the imported meshes refer to the ranges of one shared vertices list
+     *          instead of copying their vertices, it saves the memory and the time for big objects.
+     *          The mesh copies its range when it is changed by the library,
+     *          see \link ObjMesh::setSharedVertices \endlink.
+     *          Default value is false.
+     * \param [in] state
+     */
+    void setSharedMeshVertices(const bool state) { mIsSharedMeshVertices = state; }
+
+    /*! \see \link ImportContext::setSharedMeshVertices \endlink */
+    bool isSharedMeshVertices() const { return mIsSharedMeshVertices; }
+
+    /// @}
+    //-------------------------------------------------------------------------
 
 private:
 
@@ -125,6 +156,8 @@ private:
     Path mCommandsFile;
     IOStatistic mStatistic;
     std::unique_ptr<IInterrupter> mInterruptor;
+    std::size_t mWorkerThreads = 1;
+    bool mIsSharedMeshVertices = false;
 
 };
 
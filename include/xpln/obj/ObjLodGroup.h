@@ -37,6 +37,20 @@ namespace xobj {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
 
+/*!
+ * \details Parameters of the LOD which is generated from the LOD with "near" value 0.0.
+ * \see \link ObjMain::generateLods \endlink
+ * \ingroup Objects
+ */
+struct LodLevel {
+    float pFar;        //!< "far" value of the LOD, its "near" value is the "far" value of the previous LOD.
+    float pFacesRatio; //!< Part of the source meshes' faces that is kept, (0.0, 1.0].
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
 /*!
  * \details Representation of the LOD object
  * \ingroup Objects
@@ -122,6 +122,20 @@ public:
      */
     const Lods & lods() const { return mLods; }
 
+    /*!
+     * \details Generates new LODs from the LOD whose "near" value is 0.0.
+     *          Each generated LOD is a copy of that LOD where the meshes are decimated,
+     *          the meshes with the hard attribute or the manipulator are copied without decimation
+     *          and the hard attribute is removed from them as only the first LOD can have it.
+     * \param [in] levels the generated LODs in ascending order of their "far" values,
+     *                    the first one starts from the "far" value of the source LOD.
+     * \param [in] interrupt
+     * \return False if the source LOD isn't found, the levels are incorrect
+     *         or other LODs overlap the generated distance range.
+     *         Information about problems is printed to the log.
+     */
+    XpObjLib bool generateLods(const std::vector<LodLevel> & levels, const IInterrupter & interrupt = NoInterrupter());
+
     /// @}
     //-------------------------------------------------------------------------
     /// @{
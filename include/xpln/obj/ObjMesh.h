@@ -28,6 +28,9 @@
 **
 **  Contacts: www.steptosky.com
 */
+#include <cstddef>
+#include <memory>
+#include <vector>
 #include "ObjAbstract.h"
 #include "MeshVertex.h"
 #include "MeshFace.h"
@@ -54,6 +57,7 @@ public:
     typedef MeshFace Face;
     typedef std::vector<MeshVertex> VertexList;
     typedef std::vector<MeshFace> FaceList;
+    typedef std::shared_ptr<const VertexList> SharedVertexList;
 
     //-------------------------------------------------------------------------
 
@@ -70,6 +74,8 @@ public:
 
     /*!
      * \details Vertices list.
+     * \note It is empty while the mesh uses the shared vertices,
+     *       see \link ObjMesh::setSharedVertices \endlink.
      */
     VertexList pVertices;
 
@@ -78,6 +84,54 @@ public:
      */
     FaceList pFaces;
 
+    //-------------------------------------------------------------------------
+    /// \name Shared vertices
+    /// @{
+
+    /*!
+     * \details Makes the mesh use the range of the vertices list which is shared with other meshes
+     *          instead of its own \link ObjMesh::pVertices \endlink, the own vertices are cleared.
+     *          The faces index the vertices relative to the range beginning.
+     *          It is used by the import, so many meshes can refer to one big vertices table without copies.
+     * \details The library's methods which change the vertices copy the range
+     *          to the own vertices first (copy-on-write), see \link ObjMesh::detachVertices \endlink.
+     *          If you change \link ObjMesh::pVertices \endlink directly, call it before.
+     * \param [in] vertices nullptr means the mesh uses its own vertices.
+     * \param [in] offset of the range.
+     * \param [in] count of the range, offset + count must not be greater than vertices count.
+     */
+    XpObjLib void setSharedVertices(SharedVertexList vertices, std::size_t offset, std::size_t count);
+
+    /*!
+     * \details Copies the shared vertices range to the own vertices and releases the shared list.
+     *          Nothing is done if the mesh uses its own vertices.
+     */
+    XpObjLib void detachVertices();
+
+    /*! \see \link ObjMesh::setSharedVertices \endlink */
+    bool hasSharedVertices() const { return mSharedVertices != nullptr; }
+
+    /*! \see \link ObjMesh::setSharedVertices \endlink */
+    const SharedVertexList & sharedVertices() const { return mSharedVertices; }
+
+    /*! \see \link ObjMesh::setSharedVertices \endlink */
+    std::size_t sharedVerticesOffset() const { return mSharedOffset; }
+
+    /*!
+     * \details Vertices of the mesh, the own or the shared range.
+     *          Use it for reading the vertices if the mesh may use the shared ones.
+     * \see \link ObjMesh::verticesCount \endlink
+     */
+    const MeshVertex * vertices() const {
+        return mSharedVertices ? mSharedVertices->data() + mSharedOffset : pVertices.data();
+    }
+
+    /*! \see \link ObjMesh::vertices \endlink */
+    std::size_t verticesCount() const {
+        return mSharedVertices ? mSharedCount : pVertices.size();
+    }
+
+    /// @}
     //-------------------------------------------------------------------------
 
     /*!
@@ -112,6 +166,9 @@ public:
 private:
 
     bool mTwoSided = false;
+    SharedVertexList mSharedVertices;
+    std::size_t mSharedOffset = 0;
+    std::size_t mSharedCount = 0;
 
 };
 
@@ -35,7 +35,12 @@
 #include <string>
 #include <iosfwd>
 #include <algorithm>
+#include <unordered_set>
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
 #include "xpln/utils/Path.h"
+#include "xpln/utils/StringRef.h"
 
 namespace xobj {
 
@@ -105,6 +110,38 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
 
+/*!
+ * \brief Represents one command without copying its text.
+ * \details The fields reference the parsed data, they are valid only inside the parser's callback.
+ *          Use \link CommandRef::toCommand \endlink for keeping the command.
+ * \ingroup Utils
+ */
+class CommandRef {
+public:
+
+    std::uint64_t mId = Command::invalidId();
+    StringRef mKey;
+    StringRef mDescription;
+
+    bool isIdValid() const { return mId != Command::invalidId(); }
+
+    /*!
+     * \details Copies the fields to the command.
+     *          The strings of the output are reused like \link DatarefRef::toDataref \endlink does.
+     * \param [out] outCmd
+     */
+    void toCommand(Command & outCmd) const {
+        outCmd.mId = mId;
+        outCmd.mKey.assign(mKey.data(), mKey.size());
+        outCmd.mDescription.assign(mDescription.data(), mDescription.size());
+    }
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
 /*!
  * \brief Represents commands file.
  * \details This class contains some methods that 
@@ -151,6 +188,26 @@ public:
      */
     XpObjLib static bool loadStream(std::istream & input, const std::function<bool(const Command &)> & callback);
 
+    /*!
+     * \details Maps the file to memory and calls \link CommandsFile::parse \endlink for it.
+     *          It is the fastest way for reading the big files.
+     * \exception std::exception
+     */
+    XpObjLib static bool mapFile(const Path & filePath, const std::function<bool(const CommandRef &)> & callback);
+
+    /*!
+     * \details Parses commands from the memory.
+     *          The fields of the commands reference the data, so no memory is allocated per line.
+     *          The result is the same as \link CommandsFile::loadStream \endlink gives.
+     * \param [in] data
+     * \param [in] size
+     * \param [in] callback this will be called for each parsed command.
+     *                      If you want to stop the process return false from the callback.
+     * \return True if whole data is processed and callback did not return false otherwise false.
+     * \exception std::exception
+     */
+    XpObjLib static bool parse(const char * data, std::size_t size, const std::function<bool(const CommandRef &)> & callback);
+
     //-------------------------------------------------------------------------
 
     /*!
@@ -174,6 +231,8 @@ public:
 
     /*!
      * \details Searches duplicates.
+     *          It compares each pair of the values so prefer
+     *          \link CommandsFile::duplicateByKey \endlink for the big containers.
      * \param [in] container
      * \param [in] fn
      * \return Iterator to found duplicate or Container::end()
@@ -184,7 +243,7 @@ public:
                                                                            const typename Container::value_type & v2)> fn) {
 
         for (auto iter = container.begin(); iter != container.end(); ++iter) {
-            auto findIter = std::find_if(iter, container.end(), [&](const auto & val) { return fn(*iter, val); });
+            auto findIter = std::find_if(std::next(iter), container.end(), [&](const auto & val) { return fn(*iter, val); });
             if (findIter != container.end()) {
                 return findIter;
             }
@@ -192,6 +251,25 @@ public:
         return container.end();
     }
 
+    /*!
+     * \details Searches duplicates by the hashed keys in one pass.
+     * \param [in] container
+     * \param [in] keyFn returns the key of the value, the key must be supported by std::hash.
+     * \return Iterator to the first value which key was met before or Container::end()
+     */
+    template<typename Container, typename KeyFn>
+    static typename Container::const_iterator duplicateByKey(const Container & container, KeyFn keyFn) {
+        typedef typename std::decay<decltype(keyFn(*container.begin()))>::type Key;
+        std::unordered_set<Key> keys;
+        keys.reserve(static_cast<std::size_t>(std::distance(container.begin(), container.end())));
+        for (auto iter = container.begin(); iter != container.end(); ++iter) {
+            if (!keys.insert(keyFn(*iter)).second) {
+                return iter;
+            }
+        }
+        return container.end();
+    }
+
     /// @}
     //-------------------------------------------------------------------------
 
@@ -35,7 +35,12 @@
 #include <string>
 #include <iosfwd>
 #include <algorithm>
+#include <unordered_set>
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
 #include "xpln/utils/Path.h"
+#include "xpln/utils/StringRef.h"
 
 namespace xobj {
 
@@ -123,6 +128,45 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
 
+/*!
+ * \brief Represents one dataref without copying its text.
+ * \details The fields reference the parsed data, they are valid only inside the parser's callback.
+ *          Use \link DatarefRef::toDataref \endlink for keeping the dataref.
+ * \ingroup Utils
+ */
+class DatarefRef {
+public:
+
+    bool mWritable = false;
+    std::uint64_t mId = Dataref::invalidId();
+    StringRef mKey;
+    StringRef mValueType;
+    StringRef mValueUnits;
+    StringRef mDescription;
+
+    bool isIdValid() const { return mId != Dataref::invalidId(); }
+
+    /*!
+     * \details Copies the fields to the dataref.
+     *          The strings of the output are reused, so filling the same dataref doesn't allocate memory
+     *          when its strings are big enough.
+     * \param [out] outDrf
+     */
+    void toDataref(Dataref & outDrf) const {
+        outDrf.mWritable = mWritable;
+        outDrf.mId = mId;
+        outDrf.mKey.assign(mKey.data(), mKey.size());
+        outDrf.mValueType.assign(mValueType.data(), mValueType.size());
+        outDrf.mValueUnits.assign(mValueUnits.data(), mValueUnits.size());
+        outDrf.mDescription.assign(mDescription.data(), mDescription.size());
+    }
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
 /*!
  * \brief Represents datarefs file.
  * \details This class contains some methods that 
@@ -169,6 +213,26 @@ public:
      */
     XpObjLib static bool loadStream(std::istream & input, const std::function<bool(const Dataref &)> & callback);
 
+    /*!
+     * \details Maps the file to memory and calls \link DatarefsFile::parse \endlink for it.
+     *          It is the fastest way for reading the big files.
+     * \exception std::exception
+     */
+    XpObjLib static bool mapFile(const Path & filePath, const std::function<bool(const DatarefRef &)> & callback);
+
+    /*!
+     * \details Parses datarefs from the memory.
+     *          The fields of the datarefs reference the data, so no memory is allocated per line.
+     *          The result is the same as \link DatarefsFile::loadStream \endlink gives.
+     * \param [in] data
+     * \param [in] size
+     * \param [in] callback this will be called for each parsed dataref.
+     *                      If you want to stop the process return false from the callback.
+     * \return True if whole data is processed and callback did not return false otherwise false.
+     * \exception std::exception
+     */
+    XpObjLib static bool parse(const char * data, std::size_t size, const std::function<bool(const DatarefRef &)> & callback);
+
     //-------------------------------------------------------------------------
 
     /*!
@@ -192,6 +256,8 @@ public:
 
     /*!
      * \details Searches duplicates.
+     *          It compares each pair of the values so prefer
+     *          \link DatarefsFile::duplicateByKey \endlink for the big containers.
      * \param [in] container
      * \param [in] fn
      * \return Iterator to found duplicate or Container::end()
@@ -202,7 +268,7 @@ public:
                                                                            const typename Container::value_type & v2)> fn) {
 
         for (auto iter = container.begin(); iter != container.end(); ++iter) {
-            auto findIter = std::find_if(iter, container.end(), [&](const auto & val) { return fn(*iter, val); });
+            auto findIter = std::find_if(std::next(iter), container.end(), [&](const auto & val) { return fn(*iter, val); });
             if (findIter != container.end()) {
                 return findIter;
             }
@@ -210,6 +276,28 @@ public:
         return container.end();
     }
 
+    /*!
+     * \details Searches duplicates by the hashed keys in one pass.
+     * \code
+     * auto iter = DatarefsFile::duplicateByKey(datarefs, [](const Dataref & d) { return d.mId; });
+     * \endcode
+     * \param [in] container
+     * \param [in] keyFn returns the key of the value, the key must be supported by std::hash.
+     * \return Iterator to the first value which key was met before or Container::end()
+     */
+    template<typename Container, typename KeyFn>
+    static typename Container::const_iterator duplicateByKey(const Container & container, KeyFn keyFn) {
+        typedef typename std::decay<decltype(keyFn(*container.begin()))>::type Key;
+        std::unordered_set<Key> keys;
+        keys.reserve(static_cast<std::size_t>(std::distance(container.begin(), container.end())));
+        for (auto iter = container.begin(); iter != container.end(); ++iter) {
+            if (!keys.insert(keyFn(*iter)).second) {
+                return iter;
+            }
+        }
+        return container.end();
+    }
+
     /// @}
     //-------------------------------------------------------------------------
 
@@ -0,0 +1,147 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include "xpln/Export.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <iosfwd>
+#include "xpln/utils/Path.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \brief Entries (datarefs or commands) indexed by their ids.
+ * \details It is used for resolving the datarefs and commands that are specified as id while exporting.
+ *          The registry is immutable after loading, so one instance can be shared
+ *          between any number of exports and threads.
+ *          Load the file once and set the registry to each \link ExportContext::setDatarefRegistry \endlink
+ *          or \link ExportContext::setCommandRegistry \endlink instead of parsing the file for each export.
+ * \note It is instantiated only for \link Dataref \endlink and \link Command \endlink,
+ *       see \link DatarefRegistry \endlink and \link CommandRegistry \endlink.
+ * \ingroup Utils
+ */
+template<typename Entry>
+class IdRegistry {
+
+    //-------------------------------------------------------------------------
+    /// @{
+
+    IdRegistry() = default;
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+public:
+
+    //-------------------------------------------------------------------------
+    /// @{
+
+    typedef std::shared_ptr<const IdRegistry> Ptr;
+
+    IdRegistry(const IdRegistry &) = delete;
+    IdRegistry(IdRegistry &&) = delete;
+
+    ~IdRegistry() = default;
+
+    IdRegistry & operator=(const IdRegistry &) = delete;
+    IdRegistry & operator=(IdRegistry &&) = delete;
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// \name Loading
+    /// @{
+
+    /*!
+     * \details Parses the datarefs or commands file.
+     *          The entries without id are skipped.
+     *          If the file contains duplicated ids then the first entry is used and the error is logged.
+     * \exception std::exception
+     */
+    XpObjLib static Ptr loadFile(const Path & filePath);
+
+    /*! \copydoc IdRegistry::loadFile */
+    XpObjLib static Ptr loadStream(std::istream & input);
+
+    /*!
+     * \details Returns the registry from the process-wide cache or loads it by
+     *          \link IdRegistry::loadFile \endlink if the file isn't cached yet.
+     *          It is thread-safe, the file is parsed only once even if it is requested concurrently,
+     *          the requests for other files aren't blocked while it is parsed.
+     *          The cache keeps a limited count of the last used files,
+     *          the registries stay in it until they are evicted or \link IdRegistry::clearCache \endlink is called.
+     * \param [in] filePath
+     * \param [in] revalidate if it is true then the file modification time and size are checked
+     *                        and the file is reloaded if they were changed.
+     * \exception std::exception
+     */
+    XpObjLib static Ptr cached(const Path & filePath, bool revalidate = true);
+
+    /*!
+     * \details Removes all registries from the process-wide cache.
+     *          The registries that are still used by someone stay valid.
+     */
+    XpObjLib static void clearCache();
+
+    /// @}
+    //-------------------------------------------------------------------------
+    /// \name Access
+    /// @{
+
+    /*!
+     * \return Entry with the specified id or nullptr.
+     */
+    const Entry * find(const std::uint64_t id) const {
+        const auto iter = mEntries.find(id);
+        return iter != mEntries.end() ? &iter->second : nullptr;
+    }
+
+    std::size_t size() const { return mEntries.size(); }
+    bool empty() const { return mEntries.empty(); }
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+private:
+
+    std::unordered_map<std::uint64_t, Entry> mEntries;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
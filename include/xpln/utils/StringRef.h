@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \brief Non-owning reference to a piece of text.
+ * \details It is used by the parsers for passing the fields without copying them.
+ *          The referenced data must be alive while the reference is used.
+ * \ingroup Utils
+ */
+class StringRef {
+public:
+
+    //-------------------------------------------------------------------------
+
+    StringRef() = default;
+    StringRef(const char * data, const std::size_t size)
+        : mData(data),
+          mSize(size) {}
+
+    StringRef(const std::string & str)
+        : mData(str.data()),
+          mSize(str.size()) {}
+
+    //-------------------------------------------------------------------------
+
+    const char * data() const { return mData; }
+    std::size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    const char * begin() const { return mData; }
+    const char * end() const { return mData + mSize; }
+
+    char front() const { return *mData; }
+
+    std::string str() const { return std::string(mData, mSize); }
+
+    //-------------------------------------------------------------------------
+
+    bool operator==(const StringRef & other) const {
+        return mSize == other.mSize && (mSize == 0 || std::memcmp(mData, other.mData, mSize) == 0);
+    }
+
+    bool operator!=(const StringRef & other) const {
+        return !(*this == other);
+    }
+
+    //-------------------------------------------------------------------------
+
+private:
+
+    const char * mData = nullptr;
+    std::size_t mSize = 0;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
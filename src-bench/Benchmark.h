@@ -0,0 +1,199 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include <numeric>
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Measures the time of the code which is between start() and stop(),
+ *          so the preparing of each repetition isn't included.
+ */
+class Stopwatch {
+public:
+
+    void start() {
+        mStart = std::chrono::steady_clock::now();
+    }
+
+    void stop() {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mStart;
+        mSeconds += elapsed.count();
+    }
+
+    double seconds() const { return mSeconds; }
+
+private:
+
+    std::chrono::steady_clock::time_point mStart;
+    double mSeconds = 0.0;
+
+};
+
+/*!
+ * \details Result of one benchmark case.
+ */
+struct BenchResult {
+    std::string pName;
+    std::size_t pItems = 0; //!< Processed items (vertices, points, matrices) of one repetition.
+    std::vector<double> pSeconds;
+
+    double min() const {
+        return pSeconds.empty() ? 0.0 : *std::min_element(pSeconds.begin(), pSeconds.end());
+    }
+
+    double mean() const {
+        return pSeconds.empty() ? 0.0 : std::accumulate(pSeconds.begin(), pSeconds.end(), 0.0) / double(pSeconds.size());
+    }
+
+    double median() const {
+        if (pSeconds.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted = pSeconds;
+        std::sort(sorted.begin(), sorted.end());
+        const std::size_t middle = sorted.size() / 2;
+        return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) * 0.5;
+    }
+};
+
+/*!
+ * \details Runs the function several times.
+ * \param [in] name
+ * \param [in] repeats
+ * \param [in] items see BenchResult::pItems.
+ * \param [in] function void(Stopwatch &), it calls start() and stop() around the measured code.
+ */
+template<typename Function>
+BenchResult runBenchmark(const std::string & name, const std::size_t repeats, const std::size_t items, const Function & function) {
+    BenchResult result;
+    result.pName = name;
+    result.pItems = items;
+    for (std::size_t i = 0; i < repeats; ++i) {
+        Stopwatch stopwatch;
+        function(stopwatch);
+        result.pSeconds.emplace_back(stopwatch.seconds());
+    }
+    return result;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Minimal JSON printer for the report, the keys and the string values must not need escaping.
+ */
+class JsonWriter {
+public:
+
+    explicit JsonWriter(std::ostream & stream)
+        : mStream(stream) {
+        mStream.precision(9);
+        mStream << std::boolalpha;
+    }
+
+    void beginObject(const char * key = nullptr) {
+        begin(key, '{');
+    }
+
+    void endObject() {
+        end('}');
+    }
+
+    void beginArray(const char * key = nullptr) {
+        begin(key, '[');
+    }
+
+    void endArray() {
+        end(']');
+    }
+
+    void value(const char * key, const std::string & val) {
+        printKey(key);
+        mStream << '"' << val << '"';
+    }
+
+    void value(const char * key, const char * val) {
+        value(key, std::string(val));
+    }
+
+    template<typename T>
+    void value(const char * key, const T val) {
+        printKey(key);
+        mStream << val;
+    }
+
+private:
+
+    void begin(const char * key, const char bracket) {
+        printKey(key);
+        mStream << bracket;
+        mFirst.emplace_back(true);
+    }
+
+    void end(const char bracket) {
+        mFirst.pop_back();
+        mStream << '\n' << std::string(mFirst.size() * 2, ' ') << bracket;
+        if (mFirst.empty()) {
+            mStream << '\n';
+        }
+    }
+
+    void printKey(const char * key) {
+        if (!mFirst.empty()) {
+            if (!mFirst.back()) {
+                mStream << ',';
+            }
+            mFirst.back() = false;
+            mStream << '\n' << std::string(mFirst.size() * 2, ' ');
+        }
+        if (key) {
+            mStream << '"' << key << "\": ";
+        }
+    }
+
+    std::ostream & mStream;
+    std::vector<bool> mFirst;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,178 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "SceneGenerator.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLightPoint.h"
+#include "xpln/obj/manipulators/AttrManipPush.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details xorshift64* generator, unlike the std distributions
+ *          its sequence is the same for all the compilers.
+ */
+class Random {
+public:
+
+    explicit Random(const std::uint64_t seed)
+        : mState(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+    std::uint64_t next() {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return mState * 2685821657736338717ULL;
+    }
+
+    /*! \return Value in [0, 1). */
+    float nextFloat() {
+        return float(next() >> 40) / float(1ULL << 24);
+    }
+
+    /*! \return Value in [min, max). */
+    float nextFloat(const float min, const float max) {
+        return min + (max - min) * nextFloat();
+    }
+
+private:
+
+    std::uint64_t mState;
+
+};
+
+static ObjMesh * createGrid(const std::size_t meshIndex, const std::size_t vertices, Random & random) {
+    const std::size_t side = std::max(std::size_t(2), std::size_t(std::sqrt(double(vertices))));
+    const Point3 origin(random.nextFloat(-500.0f, 500.0f), random.nextFloat(-500.0f, 500.0f), random.nextFloat(0.0f, 50.0f));
+    const float step = 0.25f;
+
+    auto * mesh = new ObjMesh();
+    mesh->setObjectName("mesh " + std::to_string(meshIndex));
+    mesh->pVertices.reserve(side * side);
+    for (std::size_t y = 0; y < side; ++y) {
+        for (std::size_t x = 0; x < side; ++x) {
+            const Point3 pos(origin.x + float(x) * step, origin.y + float(y) * step,
+                             origin.z + random.nextFloat(-0.1f, 0.1f));
+            mesh->pVertices.emplace_back(MeshVertex(pos, Point3(0.0f, 0.0f, 1.0f),
+                                                    Point2(float(x) / float(side - 1), float(y) / float(side - 1))));
+        }
+    }
+    mesh->pFaces.reserve((side - 1) * (side - 1) * 2);
+    for (std::size_t y = 0; y + 1 < side; ++y) {
+        for (std::size_t x = 0; x + 1 < side; ++x) {
+            const std::size_t i = y * side + x;
+            mesh->pFaces.emplace_back(MeshFace(i, i + 1, i + side));
+            mesh->pFaces.emplace_back(MeshFace(i + 1, i + side + 1, i + side));
+        }
+    }
+    return mesh;
+}
+
+static void animate(Transform & transform, const std::size_t index, Random & random) {
+    transform.pAnimTrans.emplace_back(AnimTrans());
+    AnimTrans & trans = transform.pAnimTrans.back();
+    trans.pDrf = "bench/trans/" + std::to_string(index);
+    trans.pKeys.emplace_back(AnimTransKey(0.0f, 0.0f, 0.0f, 0.0f));
+    trans.pKeys.emplace_back(AnimTransKey(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f),
+                                          random.nextFloat(-1.0f, 1.0f), 1.0f));
+
+    transform.pAnimRotate.emplace_back(AnimRotate());
+    AnimRotate & rotate = transform.pAnimRotate.back();
+    rotate.pDrf = "bench/rotate/" + std::to_string(index);
+    rotate.pVector = Point3(0.0f, 0.0f, 1.0f);
+    rotate.pKeys.emplace_back(AnimRotateKey(0.0f, 0.0f));
+    rotate.pKeys.emplace_back(AnimRotateKey(random.nextFloat(-180.0f, 180.0f), 1.0f));
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+void SceneGenerator::generate(ObjMain & outMain, const SceneParams & params) {
+    Random random(params.pSeed);
+    outMain.setObjectName("bench");
+    outMain.pAttr.setTexture("bench.png");
+    ObjLodGroup & lod = outMain.addLod(new ObjLodGroup("bench", 0.0f, 10000.0f));
+
+    //-------------------------------------------------------------------------
+    // hierarchy: each level has 2 children per parent, the objects are distributed among all the transforms.
+
+    std::vector<Transform*> transforms = {&lod.transform()};
+    std::size_t levelBegin = 0;
+    for (std::size_t level = 0; level < params.pDepth; ++level) {
+        const std::size_t levelEnd = transforms.size();
+        for (std::size_t i = levelBegin; i < levelEnd; ++i) {
+            for (std::size_t c = 0; c < 2; ++c) {
+                Transform & child = transforms[i]->newChild(("transform " + std::to_string(transforms.size())).c_str());
+                if (random.nextFloat() < params.pAnimDensity) {
+                    animate(child, transforms.size(), random);
+                }
+                transforms.emplace_back(&child);
+            }
+        }
+        levelBegin = levelEnd;
+    }
+
+    //-------------------------------------------------------------------------
+
+    const std::size_t meshVertices = params.pMeshes != 0 ? params.pVertices / params.pMeshes : 0;
+    for (std::size_t i = 0; i < params.pMeshes; ++i) {
+        ObjMesh * mesh = createGrid(i, meshVertices, random);
+        if (random.nextFloat() < params.pManipDensity) {
+            auto * manip = new AttrManipPush();
+            manip->setDataref("bench/manip/" + std::to_string(i));
+            manip->setToolTip("bench");
+            manip->setDown(0.0f);
+            manip->setUp(1.0f);
+            mesh->pAttr.setManipulator(manip);
+        }
+        transforms[i % transforms.size()]->addObject(mesh);
+    }
+
+    for (std::size_t i = 0; i < params.pLights; ++i) {
+        auto * light = new ObjLightPoint();
+        light->setObjectName("light " + std::to_string(i));
+        light->setPosition(Point3(random.nextFloat(-500.0f, 500.0f), random.nextFloat(-500.0f, 500.0f),
+                                  random.nextFloat(0.0f, 50.0f)));
+        light->setColor(Color(random.nextFloat(), random.nextFloat(), random.nextFloat()));
+        transforms[i % transforms.size()]->addObject(light);
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
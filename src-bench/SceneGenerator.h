@@ -0,0 +1,73 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include "xpln/obj/ObjMain.h"
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Parameters of the synthetic scene.
+ */
+struct SceneParams {
+    std::size_t pVertices = 1000000; //!< Total mesh vertices count.
+    std::size_t pMeshes = 100;       //!< Meshes count, the vertices are split between them.
+    std::size_t pDepth = 4;          //!< Depth of the transforms hierarchy under the LOD.
+    float pAnimDensity = 0.25f;      //!< Part [0, 1] of the transforms which are animated.
+    std::size_t pLights = 1000;      //!< Light points count.
+    float pManipDensity = 0.1f;      //!< Part [0, 1] of the meshes which have a manipulator.
+    std::uint64_t pSeed = 1;         //!< The same seed makes the same scene on all the platforms.
+};
+
+/*!
+ * \details Makes the deterministic scenes for the benchmarks.
+ */
+class SceneGenerator {
+    SceneGenerator() = default;
+    ~SceneGenerator() = default;
+public:
+
+    /*!
+     * \details Fills the object with one LOD containing the transforms hierarchy
+     *          with the grid meshes, the animations, the manipulators and the light points.
+     * \param [out] outMain it must be empty.
+     * \param [in] params
+     */
+    static void generate(xobj::ObjMain & outMain, const SceneParams & params);
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,364 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "xpln/Info.h"
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/MeshVertex.h"
+#include "xpln/common/TMatrix.h"
+#include "io/ObjTransformation.h"
+#include "io/reader/NumberParse.h"
+#include "io/writer/AbstractWriter.h"
+#include "converters/ObjString.h"
+#include "sts/geometry/TMatrix3.h"
+#include "sts/geometry/Quaternion.h"
+#include "sts/geometry/Converters.h"
+#include "Benchmark.h"
+#include "SceneGenerator.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * Usage: bench-XplnObj [--vertices=N] [--meshes=N] [--depth=N] [--anim=F] [--lights=N] [--manip=F]
+ *                      [--seed=N] [--repeats=N] [--threads=N] [--file=PATH] [--json=PATH]
+ * The report is printed to the stdout if --json isn't specified.
+ */
+
+struct BenchParams {
+    SceneParams pScene;
+    std::size_t pRepeats = 5;
+    std::size_t pThreads = 1;
+    std::string pFile = "bench-XplnObj.obj";
+    std::string pJson;
+};
+
+static bool parseArgs(const int argc, char ** argv, BenchParams & outParams) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const auto eq = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+            std::cerr << "Incorrect argument: " << arg << std::endl;
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string val = arg.substr(eq + 1);
+        const auto toSize = [&]() { return std::size_t(std::strtoull(val.c_str(), nullptr, 10)); };
+        if (key == "vertices") { outParams.pScene.pVertices = toSize(); }
+        else if (key == "meshes") { outParams.pScene.pMeshes = toSize(); }
+        else if (key == "depth") { outParams.pScene.pDepth = toSize(); }
+        else if (key == "anim") { outParams.pScene.pAnimDensity = std::strtof(val.c_str(), nullptr); }
+        else if (key == "lights") { outParams.pScene.pLights = toSize(); }
+        else if (key == "manip") { outParams.pScene.pManipDensity = std::strtof(val.c_str(), nullptr); }
+        else if (key == "seed") { outParams.pScene.pSeed = std::strtoull(val.c_str(), nullptr, 10); }
+        else if (key == "repeats") { outParams.pRepeats = std::max(toSize(), std::size_t(1)); }
+        else if (key == "threads") { outParams.pThreads = toSize(); }
+        else if (key == "file") { outParams.pFile = val; }
+        else if (key == "json") { outParams.pJson = val; }
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static TMatrix sceneMatrix() {
+    TMatrix tm;
+    tm.rotateDegreesX(-90.0f);
+    tm.setPosition(Point3(10.0f, 20.0f, 30.0f));
+    return tm;
+}
+
+static bool exportScene(ObjMain & main, const BenchParams & params, IOStatistic * outStat = nullptr) {
+    ExportContext context(params.pFile);
+    context.setWorkerThreads(params.pThreads);
+    context.setSignature("bench");
+    if (!main.exportObj(context)) {
+        return false;
+    }
+    if (outStat) {
+        *outStat = context.statistic();
+    }
+    return true;
+}
+
+static bool importScene(const BenchParams & params, IOStatistic * outStat = nullptr) {
+    ObjMain main;
+    ImportContext context(params.pFile);
+    context.setWorkerThreads(params.pThreads);
+    if (!main.importObj(context)) {
+        return false;
+    }
+    if (outStat) {
+        *outStat = context.statistic();
+    }
+    return true;
+}
+
+/*!
+ * \details Collects the printed lines to one text like the obj file has.
+ */
+class TextWriter : public AbstractWriter {
+public:
+
+    void printLine(const char * msg) override {
+        mText.append(msg).append("\n");
+    }
+
+    const std::string & actualDataref(const std::string & dataref) override { return dataref; }
+    const std::string & actualCommand(const std::string & command) override { return command; }
+
+    const std::string & text() const { return mText; }
+
+private:
+
+    std::string mText;
+
+};
+
+static std::string vtLines(const std::size_t count) {
+    TextWriter writer;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float v = float(i % 1000);
+        const MeshVertex vertex(Point3(v * 0.37f, -v * 1.91f, v * 13.03f),
+                                Point3(0.2f, 0.5f, 0.7f),
+                                Point2(v * 0.001f, 1.0f - v * 0.001f));
+        printObj(vertex, writer, false);
+    }
+    return writer.text();
+}
+
+static void printPhase(JsonWriter & json, const char * name, const IOPhaseTime & time) {
+    json.beginObject(name);
+    json.value("wall_sec", time.pWallSec);
+    json.value("cpu_sec", time.pCpuSec);
+    json.endObject();
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+int main(const int argc, char ** argv) {
+    BenchParams params;
+    if (!parseArgs(argc, argv, params)) {
+        return EXIT_FAILURE;
+    }
+    const SceneParams & scene = params.pScene;
+    bool ok = true;
+    std::vector<BenchResult> results;
+
+    //-------------------------------------------------------------------------
+    // obj
+
+    IOStatistic exportStat;
+    results.emplace_back(runBenchmark("export", params.pRepeats, scene.pVertices, [&](Stopwatch & stopwatch) {
+        ObjMain main;
+        SceneGenerator::generate(main, scene);
+        stopwatch.start();
+        ok = exportScene(main, params, &exportStat) && ok;
+        stopwatch.stop();
+    }));
+
+    IOStatistic importStat;
+    results.emplace_back(runBenchmark("import", params.pRepeats, scene.pVertices, [&](Stopwatch & stopwatch) {
+        stopwatch.start();
+        ok = importScene(params, &importStat) && ok;
+        stopwatch.stop();
+    }));
+
+    results.emplace_back(runBenchmark("round_trip", params.pRepeats, scene.pVertices, [&](Stopwatch & stopwatch) {
+        ObjMain main;
+        SceneGenerator::generate(main, scene);
+        stopwatch.start();
+        ok = exportScene(main, params) && importScene(params) && ok;
+        stopwatch.stop();
+    }));
+
+    results.emplace_back(runBenchmark("transformation", params.pRepeats, scene.pVertices, [&](Stopwatch & stopwatch) {
+        ObjMain main;
+        SceneGenerator::generate(main, scene);
+        const TMatrix tm = sceneMatrix();
+        stopwatch.start();
+        ObjTransformation::correctExportTransform(main, tm, false);
+        stopwatch.stop();
+    }));
+
+    //-------------------------------------------------------------------------
+    // sts geometry
+
+    const std::size_t kernelItems = std::max(scene.pVertices, std::size_t(1));
+    volatile float sink = 0.0f;
+
+    results.emplace_back(runBenchmark("tmatrix_map_points", params.pRepeats, kernelItems, [&](Stopwatch & stopwatch) {
+        std::vector<sts::TMatrixF3::Vec3> points(kernelItems);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            points[i] = sts::TMatrixF3::Vec3(float(i % 1000), float(i % 977), float(i % 13));
+        }
+        sts::TMatrixF3 tm(true);
+        tm.rotateX(0.5f);
+        tm.rotateZ(0.25f);
+        tm.translate(1.0f, 2.0f, 3.0f);
+        stopwatch.start();
+        tm.mapPoints(points.data(), points.size());
+        stopwatch.stop();
+        sink = sink + points.back().x;
+    }));
+
+    results.emplace_back(runBenchmark("tmatrix_multiply", params.pRepeats, kernelItems, [&](Stopwatch & stopwatch) {
+        sts::TMatrixF3 step(true);
+        step.rotateY(0.001f);
+        step.translate(0.001f, 0.0f, 0.0f);
+        sts::TMatrixF3 tm(true);
+        stopwatch.start();
+        for (std::size_t i = 0; i < kernelItems; ++i) {
+            tm *= step;
+        }
+        stopwatch.stop();
+        sink = sink + tm(0, 0);
+    }));
+
+    results.emplace_back(runBenchmark("quaternion_convert", params.pRepeats, kernelItems, [&](Stopwatch & stopwatch) {
+        sts::TMatrixF3 tm(true);
+        sts::QuaternionF quat;
+        stopwatch.start();
+        for (std::size_t i = 0; i < kernelItems; ++i) {
+            tm.setRotateIdentity();
+            tm.rotateZ(float(i % 360) * 0.01745f);
+            sts::fromTMatrix3(quat, tm);
+            sts::fromQuat(tm, quat);
+        }
+        stopwatch.stop();
+        sink = sink + tm(1, 1);
+    }));
+
+    results.emplace_back(runBenchmark("parse_vt_lines", params.pRepeats, kernelItems, [&](Stopwatch & stopwatch) {
+        const std::string text = vtLines(kernelItems);
+        const auto * ptr = reinterpret_cast<const std::uint8_t *>(text.data());
+        const auto * end = ptr + text.size();
+        float sum = 0.0f;
+        stopwatch.start();
+        while (ptr != end) {
+            if (*ptr == '-' || (*ptr >= '0' && *ptr <= '9')) {
+                float val;
+                ptr = NumberParse::parseFloat(ptr, end, val);
+                sum += val;
+            }
+            else {
+                ++ptr;
+            }
+        }
+        stopwatch.stop();
+        sink = sink + sum;
+    }));
+
+    //-------------------------------------------------------------------------
+    // report
+
+    std::ofstream file;
+    if (!params.pJson.empty()) {
+        file.open(params.pJson);
+        if (!file) {
+            std::cerr << "The file <" << params.pJson << "> couldn't be opened." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    JsonWriter json(params.pJson.empty() ? std::cout : file);
+    json.beginObject();
+    json.value("library", XOBJ_PROJECT_NAME);
+    json.value("version", XOBJ_VERSION_STRING);
+    json.value("ok", ok);
+
+    json.beginObject("params");
+    json.value("vertices", scene.pVertices);
+    json.value("meshes", scene.pMeshes);
+    json.value("depth", scene.pDepth);
+    json.value("anim_density", scene.pAnimDensity);
+    json.value("lights", scene.pLights);
+    json.value("manip_density", scene.pManipDensity);
+    json.value("seed", scene.pSeed);
+    json.value("repeats", params.pRepeats);
+    json.value("threads", params.pThreads);
+    json.endObject();
+
+    json.beginArray("results");
+    for (const auto & result : results) {
+        json.beginObject();
+        json.value("name", result.pName);
+        json.value("items", result.pItems);
+        json.value("min_sec", result.min());
+        json.value("median_sec", result.median());
+        json.value("mean_sec", result.mean());
+        json.endObject();
+    }
+    json.endArray();
+
+    json.beginObject("export_phases");
+    printPhase(json, "lods_validation", exportStat.pTimeLodsValidation);
+    printPhase(json, "instancing", exportStat.pTimeInstancing);
+    printPhase(json, "preparing", exportStat.pTimePreparing);
+    printPhase(json, "transformation", exportStat.pTimeTransformation);
+    printPhase(json, "counting", exportStat.pTimeCounting);
+    printPhase(json, "vertices", exportStat.pTimeVertices);
+    printPhase(json, "indices", exportStat.pTimeIndices);
+    printPhase(json, "objects", exportStat.pTimeObjects);
+    printPhase(json, "total", exportStat.pTimeTotal);
+    json.value("bytes_written", exportStat.pBytesWritten);
+    json.value("peak_buffer_bytes", exportStat.pPeakBufferBytes);
+    json.endObject();
+
+    json.beginObject("import_phases");
+    printPhase(json, "file_load", importStat.pTimeFileLoad);
+    printPhase(json, "header", importStat.pTimeHeader);
+    printPhase(json, "geometry", importStat.pTimeGeometry);
+    printPhase(json, "interpretation", importStat.pTimeInterpretation);
+    printPhase(json, "total", importStat.pTimeTotal);
+    json.value("bytes_read", importStat.pBytesRead);
+    json.value("peak_buffer_bytes", importStat.pPeakBufferBytes);
+    json.endObject();
+
+    json.endObject();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
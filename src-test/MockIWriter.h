@@ -47,8 +47,8 @@ public:
     MockWriter() = default;
     virtual ~MockWriter() = default;
 
-    std::string actualDataref(const std::string & dataref) override { return dataref; }
-    std::string actualCommand(const std::string & command) override { return command; }
+    const std::string & actualDataref(const std::string & dataref) override { return dataref; }
+    const std::string & actualCommand(const std::string & command) override { return command; }
 
 };
 
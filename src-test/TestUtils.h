@@ -29,6 +29,9 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include "xpln/obj/ObjMesh.h"
 #include "gtest/gtest.h"
 #include <xpln/obj/ObjMain.h>
@@ -54,6 +57,28 @@ public:
 
     //-----------------------------------------------------
 
+    static std::string readFileContent(const Path & fileName) {
+        std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+
+    static void writeFileContent(const Path & fileName, const std::string & content) {
+        std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file << content;
+    }
+
+    static void removeFile(const Path & fileName) {
+#ifdef _MSC_VER
+        _wremove(fileName.c_str());
+#else
+        std::remove(fileName.c_str());
+#endif
+    }
+
+    //-----------------------------------------------------
+
     static void extractLod(ObjMain & main, const size_t lodNum, ObjLodGroup *& outLod) {
         ASSERT_TRUE(main.lods().size() > lodNum) << " value is " << lodNum;
         outLod = &*main.lods().at(lodNum);
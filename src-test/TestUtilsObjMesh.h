@@ -30,8 +30,10 @@
 */
 
 #include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjMain.h"
 #include "xpln/obj/attributes/AttrSet.h"
 #include "gtest/gtest.h"
+#include "TestUtils.h"
 
 namespace xobj {
 
@@ -105,6 +107,56 @@ public:
         return createPyramidTestMesh(inName, tm);
     }
 
+    /*!
+     * \details Creates plane grid mesh with side * side vertices.
+     */
+    static ObjMesh * createGridMesh(const char * inName, const std::size_t side) {
+        auto * mesh = new ObjMesh();
+        mesh->setObjectName(inName);
+        mesh->pVertices.reserve(side * side);
+        for (std::size_t y = 0; y < side; ++y) {
+            for (std::size_t x = 0; x < side; ++x) {
+                mesh->pVertices.emplace_back(ObjMesh::Vertex(Point3(float(x) * 0.25f, float(y) * 0.25f, float(x + y) * 0.01f),
+                                                             Point3(0.0f, 0.0f, 1.0f),
+                                                             Point2(float(x) / float(side), float(y) / float(side))));
+            }
+        }
+        mesh->pFaces.reserve((side - 1) * (side - 1) * 2);
+        for (std::size_t y = 0; y < side - 1; ++y) {
+            for (std::size_t x = 0; x < side - 1; ++x) {
+                const MeshFace::value_type i = y * side + x;
+                mesh->pFaces.emplace_back(ObjMesh::Face(i, i + 1, i + side));
+                mesh->pFaces.emplace_back(ObjMesh::Face(i + 1, i + side + 1, i + side));
+            }
+        }
+        return mesh;
+    }
+
+    /*!
+     * \details Adds two LODs: "l1" [0, 100] with the grid mesh of side * side vertices and the pyramid,
+     *          "l2" [100, 200] with the small grid mesh.
+     */
+    static void createTwoLodsScene(ObjMain & outMain, const std::size_t side) {
+        ObjLodGroup & lod1 = outMain.addLod(new ObjLodGroup("l1", 0.0f, 100.0f));
+        ObjLodGroup & lod2 = outMain.addLod(new ObjLodGroup("l2", 100.0f, 200.0f));
+        lod1.transform().addObject(createGridMesh("l1-m1", side));
+        lod1.transform().addObject(createPyramidTestMesh("l1-m2"));
+        lod2.transform().addObject(createGridMesh("l2-m1", 20));
+    }
+
+    /*!
+     * \details Adds LOD "l1" [0, 100] with the transform "animated"
+     *          which has the translation animation by the dataref and the pyramid mesh "m1".
+     * \return The animated transform.
+     */
+    static Transform & createAnimatedScene(ObjMain & outMain, const char * transDrf) {
+        ObjLodGroup & lod = outMain.addLod(new ObjLodGroup("l1", 0.0f, 100.0f));
+        Transform & tr = lod.transform().newChild("animated");
+        TestUtils::createTestAnimTranslate(tr.pAnimTrans, AnimTransKey(Point3(0.0f), 0.0f), AnimTransKey(Point3(1.0f), 1.0f), TMatrix(), transDrf);
+        tr.addObject(createPyramidTestMesh("m1"));
+        return tr;
+    }
+
     //-----------------------------------------------------
 
     static void compareMesh(const ObjMesh * m1, const ObjMesh * m2) {
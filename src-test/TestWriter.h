@@ -57,8 +57,8 @@ public:
 
     std::string mResult;
 
-    std::string actualDataref(const std::string & dataref) override { return dataref; }
-    std::string actualCommand(const std::string & command) override { return command; }
+    const std::string & actualDataref(const std::string & dataref) override { return dataref; }
+    const std::string & actualCommand(const std::string & command) override { return command; }
 
 private:
 
@@ -0,0 +1,125 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "algorithms/KeyframeAlg.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(KeyframeAlg, trans_linear_keys) {
+    AnimTrans anim;
+    for (std::size_t i = 0; i < 10; ++i) {
+        const float v = float(i);
+        anim.pKeys.emplace_back(AnimTransKey(v * 2.0f, 1.0f, -v, v));
+    }
+    // inside the tolerance
+    anim.pKeys[4].pPosition.x += 0.0005f;
+
+    EXPECT_EQ(8, KeyframeAlg::reduce(anim, 0.001f));
+    ASSERT_EQ(2, anim.pKeys.size());
+    EXPECT_EQ(Point3(0.0f, 1.0f, 0.0f), anim.pKeys[0].pPosition);
+    EXPECT_EQ(Point3(18.0f, 1.0f, -9.0f), anim.pKeys[1].pPosition);
+    EXPECT_EQ(9.0f, anim.pKeys[1].pDrfValue);
+}
+
+TEST(KeyframeAlg, trans_corner_is_kept) {
+    AnimTrans anim;
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 0.0f, 0.0f, 0.0f));
+    anim.pKeys.emplace_back(AnimTransKey(1.0f, 0.0f, 0.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimTransKey(2.0f, 0.0f, 0.0f, 2.0f));
+    anim.pKeys.emplace_back(AnimTransKey(2.0f, 1.0f, 0.0f, 3.0f));
+    anim.pKeys.emplace_back(AnimTransKey(2.0f, 2.0f, 0.0f, 4.0f));
+
+    EXPECT_EQ(2, KeyframeAlg::reduce(anim, 0.001f));
+    ASSERT_EQ(3, anim.pKeys.size());
+    EXPECT_EQ(2.0f, anim.pKeys[1].pDrfValue);
+}
+
+TEST(KeyframeAlg, trans_descending_dataref) {
+    AnimTrans anim;
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 0.0f, 0.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 1.0f, 0.0f, 0.5f));
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(1, KeyframeAlg::reduce(anim, 0.001f));
+    EXPECT_EQ(2, anim.pKeys.size());
+}
+
+TEST(KeyframeAlg, trans_not_monotonic_dataref) {
+    AnimTrans anim;
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 0.0f, 0.0f, 0.0f));
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 1.0f, 0.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 1.0f, 0.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimTransKey(0.0f, 2.0f, 0.0f, 2.0f));
+    EXPECT_EQ(0, KeyframeAlg::reduce(anim, 0.001f));
+    EXPECT_EQ(4, anim.pKeys.size());
+}
+
+TEST(KeyframeAlg, trans_constant) {
+    AnimTrans anim;
+    anim.pKeys.emplace_back(AnimTransKey(5.0f, 0.0f, 0.0f, 0.0f));
+    anim.pKeys.emplace_back(AnimTransKey(5.0f, 0.0f, 0.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimTransKey(5.0f, 0.0f, 0.0f, 2.0f));
+    // the offset isn't zero so it must be kept
+    EXPECT_EQ(1, KeyframeAlg::reduce(anim, 0.001f));
+    EXPECT_EQ(2, anim.pKeys.size());
+
+    for (auto & key : anim.pKeys) {
+        key.pPosition = Point3(0.0f, 0.0005f, 0.0f);
+    }
+    EXPECT_EQ(2, KeyframeAlg::reduce(anim, 0.001f));
+    EXPECT_FALSE(anim.isAnimated());
+}
+
+TEST(KeyframeAlg, rotate) {
+    AnimRotate anim;
+    anim.pVector = Point3(0.0f, 1.0f, 0.0f);
+    anim.pKeys.emplace_back(AnimRotateKey(0.0f, 0.0f));
+    anim.pKeys.emplace_back(AnimRotateKey(45.0f, 0.5f));
+    anim.pKeys.emplace_back(AnimRotateKey(90.0f, 1.0f));
+    anim.pKeys.emplace_back(AnimRotateKey(90.0f, 2.0f));
+    anim.pKeys.emplace_back(AnimRotateKey(90.005f, 3.0f));
+
+    EXPECT_EQ(2, KeyframeAlg::reduce(anim, 0.01f));
+    ASSERT_EQ(3, anim.pKeys.size());
+    EXPECT_EQ(1.0f, anim.pKeys[1].pDrfValue);
+
+    AnimRotate zero;
+    zero.pKeys.emplace_back(AnimRotateKey(0.0f, 0.0f));
+    zero.pKeys.emplace_back(AnimRotateKey(0.0f, 1.0f));
+    EXPECT_EQ(2, KeyframeAlg::reduce(zero, 0.01f));
+    EXPECT_FALSE(zero.isAnimated());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
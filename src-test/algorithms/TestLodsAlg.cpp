@@ -149,6 +149,102 @@ TEST(LodsAlg, removeWithoutObjects) {
     ASSERT_STREQ("0", lods[0]->objectName().c_str());
 }
 
+TEST(LodsAlg, generate) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod(new ObjLodGroup("lod", 0.0f, 100.0f));
+    auto * grid = TestUtilsObjMesh::createGridMesh("grid", 20);
+    lod.transform().addObject(grid);
+    auto * hard = TestUtilsObjMesh::createGridMesh("hard", 20);
+    hard->pAttr.setHard(AttrHard(ESurface(ESurface::eId::concrete)));
+    lod.transform().newChild("child").addObject(hard);
+
+    ASSERT_TRUE(main.generateLods({{300.0f, 0.5f}, {1000.0f, 0.1f}}));
+    ASSERT_EQ(3, main.lods().size());
+    EXPECT_EQ(100.0f, main.lods()[1]->nearVal());
+    EXPECT_EQ(300.0f, main.lods()[1]->farVal());
+    EXPECT_EQ(300.0f, main.lods()[2]->nearVal());
+    EXPECT_EQ(1000.0f, main.lods()[2]->farVal());
+    EXPECT_TRUE(LodsAlg::validate(main.lods(), main.objectName()));
+
+    const Transform & far = main.lods()[2]->transform();
+    ASSERT_EQ(1, far.objList().size());
+    ASSERT_EQ(1, far.childrenNum());
+    const auto * farGrid = static_cast<const ObjMesh*>(far.objList()[0].get());
+    EXPECT_GT(grid->pFaces.size() / 2, farGrid->pFaces.size());
+    const auto * farHard = static_cast<const ObjMesh*>(far.childAt(0)->objList()[0].get());
+    EXPECT_EQ(hard->pFaces.size(), farHard->pFaces.size());
+    EXPECT_FALSE(farHard->pAttr.hard());
+    // the source isn't changed
+    EXPECT_EQ(19 * 19 * 2, grid->pFaces.size());
+}
+
+TEST(LodsAlg, generate_incorrect) {
+    ObjMain main;
+    main.addLod(new ObjLodGroup("lod", 0.0f, 100.0f)).transform().addObject(TestUtilsObjMesh::createGridMesh("grid", 5));
+    EXPECT_FALSE(main.generateLods({{50.0f, 0.5f}}));
+    EXPECT_FALSE(main.generateLods({{300.0f, 0.0f}}));
+    EXPECT_FALSE(main.generateLods({{300.0f, 0.5f}, {200.0f, 0.5f}}));
+    EXPECT_EQ(1, main.lods().size());
+
+    main.lods().front()->setNearVal(10.0f);
+    EXPECT_FALSE(main.generateLods({{300.0f, 0.5f}}));
+}
+
+TEST(LodsAlg, generate_overlapped) {
+    ObjMain main;
+    main.addLod(new ObjLodGroup("lod1", 0.0f, 100.0f)).transform().addObject(TestUtilsObjMesh::createGridMesh("grid", 5));
+    main.addLod(new ObjLodGroup("lod2", 100.0f, 200.0f)).transform().addObject(TestUtilsObjMesh::createGridMesh("grid", 5));
+    EXPECT_FALSE(main.generateLods({{300.0f, 0.5f}}));
+    EXPECT_FALSE(main.generateLods({{150.0f, 0.5f}}));
+    EXPECT_EQ(2, main.lods().size());
+
+    // the range after the existing LODs is free.
+    main.lods().back()->setNearVal(300.0f);
+    main.lods().back()->setFarVal(400.0f);
+    ASSERT_TRUE(main.generateLods({{200.0f, 0.5f}, {300.0f, 0.1f}}));
+    ASSERT_EQ(4, main.lods().size());
+    EXPECT_TRUE(LodsAlg::sort(main.lods(), NoInterrupter()));
+    EXPECT_TRUE(LodsAlg::validate(main.lods(), main.objectName()));
+}
+
+TEST(LodsAlg, mergeIdenticalLods) {
+    ObjMain main;
+    const auto addLod = [&](const char * name, const float nearVal, const float farVal, const std::size_t side) {
+        ObjLodGroup & lod = main.addLod(new ObjLodGroup(name, nearVal, farVal));
+        lod.transform().newChild("child").addObject(TestUtilsObjMesh::createGridMesh("grid", side));
+    };
+    addLod("lod1", 0.0f, 100.0f, 5);
+    addLod("lod3", 300.0f, 500.0f, 5);
+    addLod("lod2", 100.0f, 300.0f, 5);
+    addLod("lod4", 500.0f, 1000.0f, 4);
+    // identical to lod1-lod3 but isn't adjacent to them
+    addLod("lod5", 2000.0f, 3000.0f, 5);
+
+    EXPECT_EQ(2, LodsAlg::mergeIdenticalLods(main.lods(), NoInterrupter()));
+    ASSERT_EQ(3, main.lods().size());
+    EXPECT_STREQ("lod1", main.lods()[0]->objectName().c_str());
+    EXPECT_EQ(0.0f, main.lods()[0]->nearVal());
+    EXPECT_EQ(500.0f, main.lods()[0]->farVal());
+    EXPECT_STREQ("lod4", main.lods()[1]->objectName().c_str());
+    EXPECT_STREQ("lod5", main.lods()[2]->objectName().c_str());
+}
+
+TEST(LodsAlg, mergeIdenticalLods_different_attributes) {
+    ObjMain main;
+    auto * m1 = TestUtilsObjMesh::createGridMesh("grid", 5);
+    auto * m2 = TestUtilsObjMesh::createGridMesh("grid", 5);
+    m2->pAttr.setTwoSided(true);
+    main.addLod(new ObjLodGroup("lod1", 0.0f, 100.0f)).transform().addObject(m1);
+    main.addLod(new ObjLodGroup("lod2", 100.0f, 300.0f)).transform().addObject(m2);
+
+    EXPECT_EQ(0, LodsAlg::mergeIdenticalLods(main.lods(), NoInterrupter()));
+    EXPECT_EQ(2, main.lods().size());
+
+    m2->pAttr.setTwoSided(false);
+    EXPECT_EQ(1, LodsAlg::mergeIdenticalLods(main.lods(), NoInterrupter()));
+    EXPECT_EQ(1, main.lods().size());
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
@@ -0,0 +1,124 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <algorithms/MeshDecimationAlg.h>
+#include "xpln/common/TMatrix.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+static float signedArea(const ObjMesh & mesh, const MeshFace & f) {
+    const Point3 & p0 = mesh.pVertices[f.pV0].pPosition;
+    const Point3 & p1 = mesh.pVertices[f.pV1].pPosition;
+    const Point3 & p2 = mesh.pVertices[f.pV2].pPosition;
+    return ((p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x)) * 0.5f;
+}
+
+static std::size_t verticesCountAtX(const ObjMesh & mesh, const float x) {
+    std::size_t count = 0;
+    for (const auto & v : mesh.pVertices) {
+        if (v.pPosition.x == x) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(MeshDecimationAlg, plane) {
+    const std::size_t side = 20;
+    std::unique_ptr<ObjMesh> mesh(TestUtilsObjMesh::createGridMesh("grid", side));
+    const std::size_t facesCount = mesh->pFaces.size();
+
+    const std::size_t removed = MeshDecimationAlg::decimate(*mesh, 100);
+    EXPECT_EQ(facesCount - removed, mesh->pFaces.size());
+    EXPECT_GE(150, mesh->pFaces.size());
+
+    // the faces aren't flipped and the border is kept so the area is the same.
+    float area = 0.0f;
+    for (const auto & f : mesh->pFaces) {
+        const float faceArea = signedArea(*mesh, f);
+        EXPECT_LT(0.0f, faceArea);
+        area += faceArea;
+    }
+    const float expectedSide = float(side - 1) * 0.25f;
+    EXPECT_NEAR(expectedSide * expectedSide, area, 0.001f);
+    EXPECT_EQ(side, verticesCountAtX(*mesh, 0.0f));
+    EXPECT_EQ(side, verticesCountAtX(*mesh, expectedSide));
+}
+
+TEST(MeshDecimationAlg, uv_seam) {
+    const std::size_t side = 20;
+    const std::size_t seamX = side / 2;
+    std::unique_ptr<ObjMesh> mesh(TestUtilsObjMesh::createGridMesh("grid", side));
+
+    // the right part of the grid uses own vertices on the seam column with another texture coordinates
+    std::vector<std::size_t> seamCopies(side);
+    for (std::size_t y = 0; y < side; ++y) {
+        ObjMesh::Vertex copy = mesh->pVertices[y * side + seamX];
+        copy.pTexture = Point2(0.0f, copy.pTexture.y);
+        seamCopies[y] = mesh->pVertices.size();
+        mesh->pVertices.emplace_back(copy);
+    }
+    for (auto & f : mesh->pFaces) {
+        const auto isRight = [&](const std::size_t v) { return v % side >= seamX; };
+        if (isRight(f.pV0) && isRight(f.pV1) && isRight(f.pV2)) {
+            for (auto * v : {&f.pV0, &f.pV1, &f.pV2}) {
+                if (*v % side == seamX) {
+                    *v = seamCopies[*v / side];
+                }
+            }
+        }
+    }
+
+    MeshDecimationAlg::decimate(*mesh, 100);
+    EXPECT_EQ(side * 2, verticesCountAtX(*mesh, float(seamX) * 0.25f));
+}
+
+TEST(MeshDecimationAlg, target_is_reached) {
+    std::unique_ptr<ObjMesh> mesh(TestUtilsObjMesh::createGridMesh("grid", 5));
+    const auto faces = mesh->pFaces;
+    const auto vertices = mesh->pVertices;
+    EXPECT_EQ(0, MeshDecimationAlg::decimate(*mesh, faces.size()));
+    EXPECT_EQ(faces, mesh->pFaces);
+    EXPECT_EQ(vertices, mesh->pVertices);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,115 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include "algorithms/VertexCacheAlg.h"
+#include "xpln/common/TMatrix.h"
+#include "TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+typedef std::array<std::size_t, 3> Triangle;
+
+static std::vector<std::size_t> shuffledGridIndices(const std::size_t side) {
+    std::unique_ptr<ObjMesh> mesh(TestUtilsObjMesh::createGridMesh("grid", side));
+    std::vector<Triangle> triangles;
+    for (const auto & f : mesh->pFaces) {
+        triangles.emplace_back(Triangle{f.pV0, f.pV1, f.pV2});
+    }
+    std::mt19937 random(42);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    std::vector<std::size_t> indices;
+    for (const auto & t : triangles) {
+        indices.insert(indices.end(), t.begin(), t.end());
+    }
+    return indices;
+}
+
+static std::vector<Triangle> sortedTriangles(const std::vector<std::size_t> & indices) {
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        triangles.emplace_back(Triangle{indices[i], indices[i + 1], indices[i + 2]});
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(VertexCacheAlg, cache_misses) {
+    const std::vector<std::size_t> indices = {0, 1, 2, 2, 1, 3, 0, 1, 4};
+    EXPECT_EQ(5, VertexCacheAlg::cacheMisses(indices.data(), indices.size(), 5));
+
+    // every index is the new one, so the first vertex is evicted by the time it is used again.
+    std::vector<std::size_t> fifo;
+    for (std::size_t i = 0; i <= VertexCacheAlg::cacheSize(); ++i) {
+        fifo.emplace_back(i);
+    }
+    fifo.emplace_back(0);
+    fifo.emplace_back(2);
+    EXPECT_EQ(VertexCacheAlg::cacheSize() + 2, VertexCacheAlg::cacheMisses(fifo.data(), fifo.size(), fifo.size()));
+}
+
+TEST(VertexCacheAlg, optimize) {
+    const std::size_t side = 100;
+    const std::vector<std::size_t> source = shuffledGridIndices(side);
+    std::vector<std::size_t> indices = source;
+    VertexCacheAlg::optimize(indices.data(), indices.size(), side * side);
+
+    // the same triangles with the same winding
+    EXPECT_EQ(sortedTriangles(source), sortedTriangles(indices));
+
+    const float triangles = float(source.size() / 3);
+    const float before = float(VertexCacheAlg::cacheMisses(source.data(), source.size(), side * side)) / triangles;
+    const float after = float(VertexCacheAlg::cacheMisses(indices.data(), indices.size(), side * side)) / triangles;
+    EXPECT_LT(after, 0.8f) << "before: " << before;
+    EXPECT_LT(after, before);
+}
+
+TEST(VertexCacheAlg, small) {
+    std::vector<std::size_t> empty;
+    VertexCacheAlg::optimize(empty.data(), 0, 0);
+
+    std::vector<std::size_t> one = {2, 1, 0};
+    VertexCacheAlg::optimize(one.data(), one.size(), 3);
+    EXPECT_EQ(std::vector<std::size_t>({2, 1, 0}), one);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,143 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <cstring>
+#include "converters/LineBuilder.h"
+#include "converters/StringStream.h"
+#include "converters/ObjString.h"
+#include "xpln/obj/MeshVertex.h"
+#include "../TestWriter.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+static std::string streamFixed(const float val, const std::uint8_t precision) {
+    StringStream out(precision);
+    out << val;
+    return out.str();
+}
+
+static std::string formatFixed(const float val, const std::uint8_t precision) {
+    char buf[NumberFormat::maxLength()];
+    return std::string(buf, NumberFormat::formatFixed(buf, val, precision));
+}
+
+static std::string formatUInt(const std::uint64_t val) {
+    char buf[NumberFormat::maxLength()];
+    return std::string(buf, NumberFormat::formatUInt(buf, val));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(NumberFormat, uint) {
+    EXPECT_STREQ("0", formatUInt(0).c_str());
+    EXPECT_STREQ("9", formatUInt(9).c_str());
+    EXPECT_STREQ("10", formatUInt(10).c_str());
+    EXPECT_STREQ("99", formatUInt(99).c_str());
+    EXPECT_STREQ("100", formatUInt(100).c_str());
+    EXPECT_STREQ("1234567", formatUInt(1234567).c_str());
+    EXPECT_EQ(std::to_string(std::numeric_limits<std::uint64_t>::max()),
+              formatUInt(std::numeric_limits<std::uint64_t>::max()));
+}
+
+TEST(NumberFormat, fixed_special_values) {
+    const float values[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 0.000005f, -0.000005f, 0.000015f, 0.000025f, 1e-7f, -1e-7f,
+        0.123455f, 0.123465f, 99999.999999f, 8388608.0f, 16777216.0f, 1e10f, -3.4e38f,
+        std::numeric_limits<float>::min(), std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(),
+    };
+    for (const float v : values) {
+        for (std::uint8_t p = 0; p < 12; ++p) {
+            ASSERT_EQ(streamFixed(v, p), formatFixed(v, p)) << " value is " << v << " precision is " << int(p);
+        }
+    }
+}
+
+TEST(NumberFormat, fixed_random_values) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<std::uint32_t> bitsDist;
+    std::uniform_real_distribution<float> realDist(-1000.0f, 1000.0f);
+    for (std::size_t i = 0; i < 200000; ++i) {
+        float v;
+        if (i % 2) {
+            const std::uint32_t bits = bitsDist(gen);
+            std::memcpy(&v, &bits, sizeof(v));
+            if (!std::isfinite(v) || std::fabs(v) > 1e12f) {
+                continue;
+            }
+        }
+        else {
+            v = realDist(gen);
+        }
+        ASSERT_EQ(streamFixed(v, PRECISION), formatFixed(v, PRECISION)) << " value is " << v;
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(LineBuilder, long_line) {
+    LineBuilder out;
+    const std::string name(1000, 'a');
+    out.add("## ").add(name).add(' ').add(1.5f).add(' ').add(std::size_t(10));
+    EXPECT_EQ(std::string("## ").append(name).append(" 1.50000 10"), out.c_str());
+    EXPECT_EQ(name.size() + 14, out.size());
+}
+
+TEST(LineBuilder, mesh_vertex) {
+    const MeshVertex vertex(Point3(-20.0f, 0.123456f, 25.5f),
+                            Point3(-0.468997f, 0.783273f, 0.408075f),
+                            Point2(0.031250f, 0.750000f));
+    StringStream expected;
+    expected << "VT " << vertex.pPosition.toString(PRECISION) << "  "
+            << vertex.pNormal.normalized().toString(PRECISION) << "  "
+            << vertex.pTexture.toString(PRECISION) << "\n";
+
+    TestWriter writer;
+    printObj(vertex, writer, false);
+    EXPECT_EQ(expected.str(), writer.mResult);
+
+    writer.clear();
+    printObj(vertex, writer, true);
+    EXPECT_EQ(std::string("VT -20.00000 0.12346 25.50000  0.00000 1.00000 0.00000  0.03125 0.75000\n"), writer.mResult);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
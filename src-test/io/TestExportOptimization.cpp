@@ -0,0 +1,453 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLightPoint.h"
+#include "xpln/obj/attributes/AttrShiny.h"
+#include "xpln/obj/attributes/AttrBlend.h"
+#include "io/writer/ExportPlan.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * Two triangles sharing an edge by duplicated vertices and one degenerate triangle,
+ * its vertex [6] becomes unused after the triangle is removed.
+ */
+static ObjMesh * createMesh(const char * name) {
+    auto * mesh = new ObjMesh();
+    mesh->setObjectName(name);
+    const Point3 normal(0.0f, 0.0f, 1.0f);
+    auto & v = mesh->pVertices;
+    v.emplace_back(MeshVertex(Point3(0.0f, 0.0f, 0.0f), normal, Point2(0.0f, 0.0f))); // 0
+    v.emplace_back(MeshVertex(Point3(1.0f, 0.0f, 0.0f), normal, Point2(1.0f, 0.0f))); // 1
+    v.emplace_back(MeshVertex(Point3(0.0f, 1.0f, 0.0f), normal, Point2(0.0f, 1.0f))); // 2
+    v.emplace_back(MeshVertex(Point3(1.0f, 0.0f, 0.0f), normal, Point2(1.0f, 0.0f))); // 3 = 1
+    v.emplace_back(MeshVertex(Point3(1.0f, 1.0f, 0.0f), normal, Point2(1.0f, 1.0f))); // 4
+    v.emplace_back(MeshVertex(Point3(0.0f, 1.0f, -0.0f), normal, Point2(0.0f, 1.0f))); // 5 = 2
+    v.emplace_back(MeshVertex(Point3(1.0f, 1.0f, 0.0f), Point3(0.0f, 0.0f, -1.0f), Point2(1.0f, 1.0f))); // 6 same position as 4
+    mesh->pFaces.emplace_back(MeshFace(0, 1, 2));
+    mesh->pFaces.emplace_back(MeshFace(3, 4, 5));
+    mesh->pFaces.emplace_back(MeshFace(4, 6, 0));
+    return mesh;
+}
+
+/*
+ * All the triangles have two corners at the same position.
+ */
+static ObjMesh * createDegenerateMesh(const char * name) {
+    auto * mesh = new ObjMesh();
+    mesh->setObjectName(name);
+    const Point3 normal(0.0f, 0.0f, 1.0f);
+    auto & v = mesh->pVertices;
+    v.emplace_back(MeshVertex(Point3(0.0f, 0.0f, 0.0f), normal, Point2(0.0f, 0.0f))); // 0
+    v.emplace_back(MeshVertex(Point3(1.0f, 0.0f, 0.0f), normal, Point2(1.0f, 0.0f))); // 1
+    v.emplace_back(MeshVertex(Point3(1.0f, 0.0f, 0.0f), normal, Point2(0.0f, 1.0f))); // 2 same position as 1
+    mesh->pFaces.emplace_back(MeshFace(0, 1, 2));
+    mesh->pFaces.emplace_back(MeshFace(1, 0, 0));
+    return mesh;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ExportOptimization, plan) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(createMesh("m1"));
+    lod.transform().addObject(createMesh("m2"));
+
+    ExportPlan plan;
+    plan.build(main);
+    plan.optimizeMeshes();
+
+    ASSERT_TRUE(plan.hasMeshTable());
+    ASSERT_EQ(4, plan.vertices().size());
+    EXPECT_EQ(2 * 2 + 4, plan.weldedVerticesCount());
+    EXPECT_EQ(2, plan.unusedVerticesCount());
+    EXPECT_EQ(2, plan.degenerateFacesCount());
+    EXPECT_EQ(4, plan.meshVerticesCount());
+    EXPECT_EQ(4, plan.meshFacesCount());
+
+    const std::vector<std::size_t> indices = {0, 1, 2, 1, 3, 2, 0, 1, 2, 1, 3, 2};
+    EXPECT_EQ(indices, plan.indices());
+
+    const auto & records = plan.records();
+    ASSERT_EQ(5, records.size());
+    EXPECT_EQ(0, records[1].mOffset);
+    EXPECT_EQ(2, records[1].mCount);
+    EXPECT_EQ(2, records[2].mOffset);
+    EXPECT_EQ(2, records[2].mCount);
+}
+
+TEST(ExportOptimization, plan_shared_ranges) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(createMesh("m1"));
+    lod.transform().addObject(createMesh("m2"));
+
+    ExportPlan plan;
+    plan.build(main);
+    plan.optimizeMeshes(true);
+
+    EXPECT_EQ(2, plan.sharedFacesCount());
+    EXPECT_EQ(2, plan.meshFacesCount());
+    const std::vector<std::size_t> indices = {0, 1, 2, 1, 3, 2};
+    EXPECT_EQ(indices, plan.indices());
+
+    const auto & records = plan.records();
+    ASSERT_EQ(5, records.size());
+    EXPECT_EQ(0, records[1].mOffset);
+    EXPECT_EQ(2, records[1].mCount);
+    EXPECT_EQ(0, records[2].mOffset);
+    EXPECT_EQ(2, records[2].mCount);
+
+    // the shared range is optimized once
+    plan.optimizeVertexCache();
+    EXPECT_EQ(6, plan.indices().size());
+    EXPECT_EQ(0, records[2].mOffset);
+}
+
+TEST(ExportOptimization, tree_normals) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    auto * m1 = TestUtilsObjMesh::createPyramidTestMesh("m1");
+    auto * m2 = TestUtilsObjMesh::createPyramidTestMesh("m2");
+    m1->pAttr.setTree(true);
+    lod.transform().addObject(m1);
+    lod.transform().addObject(m2);
+
+    ExportPlan plan;
+    plan.build(main);
+    plan.optimizeMeshes();
+
+    // the vertices are printed with different normals so they aren't welded.
+    ASSERT_EQ(m1->pVertices.size() * 2, plan.vertices().size());
+    EXPECT_EQ(0, plan.weldedVerticesCount());
+    EXPECT_EQ(Point3(0.0f, 1.0f, 0.0f), plan.vertices().front().pNormal);
+}
+
+TEST(ExportOptimization, export_import) {
+    ObjMain main;
+    TestUtils::setTestExportOptions(main);
+    main.pExportOptions.enable(XOBJ_EXP_OPTIMIZATION);
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(createMesh("m1"));
+    lod.transform().addObject(createMesh("m2"));
+
+    const auto fileName = XOBJ_PATH("ExportOptimization.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(4, stat.pMeshVerticesCount);
+    EXPECT_EQ(4, stat.pMeshFacesCount);
+    EXPECT_EQ(8, stat.pOptWeldedVerticesCount);
+    EXPECT_EQ(2, stat.pOptUnusedVerticesCount);
+    EXPECT_EQ(2, stat.pOptDegenerateFacesCount);
+
+    ObjMain inObj;
+    ImportContext impContext(fileName);
+    ASSERT_TRUE(inObj.importObj(impContext));
+    ASSERT_EQ(1, inObj.lods().size());
+    const auto & objects = inObj.lods().front()->transform().objList();
+    ASSERT_EQ(2, objects.size());
+    for (const auto & obj : objects) {
+        ASSERT_EQ(OBJ_MESH, obj->objType());
+        const auto * mesh = static_cast<const ObjMesh*>(obj.get());
+        ASSERT_EQ(2, mesh->pFaces.size());
+        ASSERT_EQ(4, mesh->pVertices.size());
+        EXPECT_EQ(Point3(1.0f, 1.0f, 0.0f), mesh->pVertices[mesh->pFaces[1].pV1].pPosition);
+    }
+}
+
+TEST(ExportOptimization, degenerate_mesh_removed) {
+    ObjMain main;
+    TestUtils::setTestExportOptions(main);
+    main.pExportOptions.enable(XOBJ_EXP_OPTIMIZATION);
+    ObjLodGroup & lod1 = main.addLod();
+    lod1.setNearVal(0.0f);
+    lod1.setFarVal(100.0f);
+    lod1.transform().addObject(createMesh("m1"));
+    ObjLodGroup & lod2 = main.addLod();
+    lod2.setNearVal(100.0f);
+    lod2.setFarVal(200.0f);
+    auto * degenerate = createDegenerateMesh("m2");
+    degenerate->pAttr.setBlend(AttrBlend(AttrBlend::no_blend, 0.5f));
+    lod2.transform().addObject(degenerate);
+
+    ExportPlan plan;
+    plan.build(main);
+    plan.optimizeMeshes();
+    EXPECT_EQ(1, plan.removedMeshesCount());
+    EXPECT_EQ(1 + 2, plan.degenerateFacesCount());
+    for (const auto & record : plan.records()) {
+        EXPECT_TRUE(record.mType != ExportPlan::RECORD_OBJECT || record.mCount != 0);
+    }
+
+    const auto fileName = XOBJ_PATH("ExportOptimization-degenerate.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    EXPECT_EQ(1 + 2, expContext.statistic().pOptDegenerateFacesCount);
+    EXPECT_EQ(1, expContext.statistic().pMeshObjCount);
+
+    ObjMain inObj;
+    ImportContext impContext(fileName);
+    ASSERT_TRUE(inObj.importObj(impContext));
+    ASSERT_EQ(2, inObj.lods().size());
+    ASSERT_EQ(1, inObj.lods()[0]->transform().objList().size());
+    EXPECT_FALSE(inObj.lods()[1]->transform().hasObjects());
+}
+
+TEST(ExportOptimization, debug_marks) {
+    ObjMain main;
+    TestUtils::setTestExportOptions(main);
+    main.pExportOptions.enable(XOBJ_EXP_OPTIMIZATION);
+    main.pExportOptions.enable(XOBJ_EXP_OPTIMIZE_VERTEX_CACHE);
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(createMesh("m1"));
+    // all its vertices are welded with the m1 ones so it hasn't the mark.
+    lod.transform().addObject(createMesh("m2"));
+    lod.transform().addObject(TestUtilsObjMesh::createPyramidTestMesh("m3"));
+
+    std::string result;
+    ExportContext expContext;
+    expContext.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(expContext));
+
+    const std::size_t m1 = result.find("\n# m1\nVT ");
+    const std::size_t m3 = result.find("\n# m3\nVT ");
+    ASSERT_NE(std::string::npos, m1);
+    ASSERT_NE(std::string::npos, m3);
+    EXPECT_LT(m1, m3);
+    EXPECT_EQ(std::string::npos, result.find("\n# m2\n"));
+    // the 4 vertices of m1 are before the m3 ones.
+    std::size_t vertices = 0;
+    for (std::size_t pos = result.find("VT ", m1); pos < m3; pos = result.find("VT ", pos + 1)) {
+        ++vertices;
+    }
+    EXPECT_EQ(4, vertices);
+}
+
+TEST(ExportOptimization, disabled) {
+    ObjMain main;
+    main.pExportOptions.disable(XOBJ_EXP_OPTIMIZATION);
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(createMesh("m1"));
+
+    const auto fileName = XOBJ_PATH("ExportOptimization-disabled.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(7, stat.pMeshVerticesCount);
+    EXPECT_EQ(3, stat.pMeshFacesCount);
+    EXPECT_EQ(0, stat.pOptWeldedVerticesCount);
+    EXPECT_EQ(0, stat.pOptUnusedVerticesCount);
+    EXPECT_EQ(0, stat.pOptDegenerateFacesCount);
+}
+
+TEST(ExportOptimization, vertex_cache) {
+    ObjMain main;
+    main.pExportOptions.disable(XOBJ_EXP_OPTIMIZATION);
+    main.pExportOptions.enable(XOBJ_EXP_OPTIMIZE_VERTEX_CACHE);
+    ObjLodGroup & lod = main.addLod();
+    auto * grid = TestUtilsObjMesh::createGridMesh("grid", 60);
+    // the column order is bad for the cache
+    std::vector<MeshFace> faces;
+    for (std::size_t x = 0; x < 59 * 2; ++x) {
+        for (std::size_t y = 0; y < 59; ++y) {
+            faces.emplace_back(grid->pFaces[y * 59 * 2 + x]);
+        }
+    }
+    grid->pFaces = faces;
+    lod.transform().addObject(createMesh("m1"));
+    lod.transform().addObject(grid);
+
+    const auto fileName = XOBJ_PATH("ExportOptimization-vertex-cache.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(60 * 60 + 7, stat.pMeshVerticesCount);
+    EXPECT_LT(stat.pOptAcmrAfter, stat.pOptAcmrBefore);
+    EXPECT_LT(stat.pOptAcmrAfter, 0.8f);
+
+    ObjMain inObj;
+    ImportContext impContext(fileName);
+    ASSERT_TRUE(inObj.importObj(impContext));
+    ASSERT_EQ(1, inObj.lods().size());
+    const auto & objects = inObj.lods().front()->transform().objList();
+    ASSERT_EQ(2, objects.size());
+    const auto * mesh = static_cast<const ObjMesh*>(objects[1].get());
+    EXPECT_EQ(faces.size(), mesh->pFaces.size());
+    EXPECT_EQ(60 * 60, mesh->pVertices.size());
+}
+
+TEST(ExportOptimization, reorder_by_attributes) {
+    ObjMain main;
+    main.pExportOptions.enable(XOBJ_EXP_REORDER_BY_ATTRIBUTES);
+    ObjLodGroup & lod = main.addLod();
+    for (std::size_t i = 0; i < 6; ++i) {
+        auto * mesh = TestUtilsObjMesh::createPyramidTestMesh("m");
+        mesh->pAttr.setBlend(AttrBlend(AttrBlend::no_blend, 0.5f));
+        if (i % 2) {
+            mesh->pAttr.setShiny(AttrShiny(0.5f));
+        }
+        lod.transform().addObject(mesh);
+    }
+
+    std::string result;
+    ExportContext expContext;
+    expContext.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(expContext));
+
+    // no_blend, shiny
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(2, stat.pTrisAttrCount);
+    EXPECT_EQ(4, stat.pOptTrisAttrAvoidedCount);
+
+    std::size_t shinyLines = 0;
+    std::size_t pos = 0;
+    while ((pos = result.find("ATTR_shiny_rat", pos)) != std::string::npos) {
+        ++shinyLines;
+        ++pos;
+    }
+    EXPECT_EQ(1, shinyLines);
+}
+
+TEST(ExportOptimization, coalesce_ranges) {
+    ObjMain main;
+    main.pExportOptions.enable(XOBJ_EXP_COALESCE_RANGES);
+    ObjLodGroup & lod = main.addLod();
+    std::size_t facesCount = 0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        auto * mesh = TestUtilsObjMesh::createPyramidTestMesh("m");
+        facesCount += mesh->pFaces.size();
+        lod.transform().addObject(mesh);
+    }
+    for (std::size_t i = 0; i < 1000; ++i) {
+        auto * light = new ObjLightPoint();
+        light->setPosition(Point3(float(i), 0.0f, 0.0f));
+        lod.transform().addObject(light);
+    }
+
+    const auto fileName = XOBJ_PATH("ExportOptimization-coalesce.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(3, stat.pMeshObjCount);
+    EXPECT_EQ(2 + 999, stat.pOptCoalescedObjCount);
+
+    const std::string content = TestUtils::readFileContent(fileName);
+    EXPECT_NE(std::string::npos, content.find("TRIS 0 " + std::to_string(facesCount * 3) + "\n"));
+    EXPECT_NE(std::string::npos, content.find("LIGHTS 0 1000\n"));
+
+    ObjMain inObj;
+    ImportContext impContext(fileName);
+    ASSERT_TRUE(inObj.importObj(impContext));
+    ASSERT_EQ(1, inObj.lods().size());
+    const auto & objects = inObj.lods().front()->transform().objList();
+    ASSERT_EQ(1, objects.size());
+    EXPECT_EQ(facesCount, static_cast<const ObjMesh*>(objects.front().get())->pFaces.size());
+}
+
+TEST(ExportOptimization, reduce_keyframes) {
+    ObjMain main;
+    main.pExportOptions.enable(XOBJ_EXP_REDUCE_KEYFRAMES);
+    ObjLodGroup & lod = main.addLod();
+    Transform & transform = lod.transform().newChild("anim");
+    transform.addObject(TestUtilsObjMesh::createPyramidTestMesh("m"));
+
+    transform.pAnimTrans.emplace_back(AnimTrans());
+    transform.pAnimTrans.back().pDrf = "sim/test/trans";
+    for (std::size_t i = 0; i <= 10; ++i) {
+        transform.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(float(i), 0.0f, 0.0f, float(i) * 0.1f));
+    }
+    // it doesn't do anything
+    transform.pAnimRotate.emplace_back(AnimRotate());
+    transform.pAnimRotate.back().pDrf = "sim/test/rotate";
+    transform.pAnimRotate.back().pVector = Point3(0.0f, 1.0f, 0.0f);
+    transform.pAnimRotate.back().pKeys.emplace_back(AnimRotateKey(0.0f, 0.0f));
+    transform.pAnimRotate.back().pKeys.emplace_back(AnimRotateKey(0.0f, 0.5f));
+    transform.pAnimRotate.back().pKeys.emplace_back(AnimRotateKey(0.0f, 1.0f));
+
+    std::string result;
+    ExportContext expContext;
+    expContext.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(expContext));
+
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(9, stat.pOptTransKeysRemovedCount);
+    EXPECT_EQ(3, stat.pOptRotateKeysRemovedCount);
+    EXPECT_EQ(1, stat.pOptAnimRemovedCount);
+
+    EXPECT_NE(std::string::npos, result.find("ANIM_trans "));
+    EXPECT_EQ(std::string::npos, result.find("ANIM_trans_begin"));
+    EXPECT_EQ(std::string::npos, result.find("ANIM_rotate"));
+    EXPECT_EQ(std::string::npos, result.find("sim/test/rotate"));
+}
+
+TEST(ExportOptimization, merge_identical_geometry) {
+    ObjMain main;
+    main.pExportOptions.enable(XOBJ_EXP_MERGE_IDENTICAL_GEOMETRY);
+    main.addLod(new ObjLodGroup("lod1", 0.0f, 100.0f)).transform().addObject(createMesh("m1"));
+    main.addLod(new ObjLodGroup("lod2", 100.0f, 300.0f)).transform().addObject(createMesh("m1"));
+    ObjLodGroup & lod3 = main.addLod(new ObjLodGroup("lod3", 300.0f, 1000.0f));
+    lod3.transform().addObject(TestUtilsObjMesh::createPyramidTestMesh("pyramid"));
+    lod3.transform().addObject(createMesh("m3"));
+
+    const auto fileName = XOBJ_PATH("ExportOptimization-merge_identical.obj");
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+    const IOStatistic & stat = expContext.statistic();
+    EXPECT_EQ(1, stat.pOptMergedLodsCount);
+    EXPECT_EQ(2, stat.pOptSharedFacesCount);
+    ASSERT_EQ(2, main.lods().size());
+    EXPECT_EQ(300.0f, main.lods()[0]->farVal());
+
+    ObjMain inObj;
+    ImportContext impContext(fileName);
+    ASSERT_TRUE(inObj.importObj(impContext));
+    ASSERT_EQ(2, inObj.lods().size());
+    EXPECT_EQ(0.0f, inObj.lods()[0]->nearVal());
+    EXPECT_EQ(300.0f, inObj.lods()[0]->farVal());
+    const auto & objects = inObj.lods()[1]->transform().objList();
+    ASSERT_EQ(2, objects.size());
+    EXPECT_EQ(2, static_cast<const ObjMesh*>(objects[1].get())->pFaces.size());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,278 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLine.h"
+#include "xpln/obj/ObjLightPoint.h"
+#include "xpln/obj/ObjDummy.h"
+#include "xpln/obj/attributes/AttrShiny.h"
+#include "xpln/obj/attributes/AttrBlend.h"
+#include "io/writer/ExportPlan.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ExportPlan, records) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    auto * m1 = TestUtilsObjMesh::createPyramidTestMesh("m1");
+    lod.transform().addObject(m1);
+
+    Transform & child = lod.transform().newChild("child");
+    child.pAnimTrans.emplace_back(AnimTrans());
+    child.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(1.0f, 1.0f, 1.0f, 1.0f));
+    child.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(2.0f, 2.0f, 2.0f, 2.0f));
+
+    auto * line = new ObjLine();
+    line->verticesList().resize(3);
+    child.addObject(line);
+    auto * light = new ObjLightPoint();
+    child.addObject(light);
+    auto * m2 = TestUtilsObjMesh::createPyramidTestMesh("m2");
+    m2->pAttr.setTree(true);
+    child.addObject(m2);
+    auto * dummy = new ObjDummy();
+    child.newChild("not-animated").addObject(dummy);
+
+    auto * m3 = TestUtilsObjMesh::createPyramidTestMesh("m3");
+    main.pDraped.transform().addObject(m3);
+
+    ExportPlan plan;
+    plan.build(main);
+
+    //-------------------------------------------------------------------------
+
+    const auto & records = plan.records();
+    ASSERT_EQ(11, records.size());
+    EXPECT_EQ(ExportPlan::RECORD_LOD, records[0].mType);
+    EXPECT_EQ(&lod, records[0].mLod);
+
+    EXPECT_EQ(ExportPlan::RECORD_OBJECT, records[1].mType);
+    EXPECT_EQ(m1, records[1].mObject);
+    EXPECT_EQ(0, records[1].mOffset);
+    EXPECT_EQ(0, records[1].mAttrState);
+
+    EXPECT_EQ(ExportPlan::RECORD_ANIM_BEGIN, records[2].mType);
+    EXPECT_EQ(&child, records[2].mTransform);
+
+    EXPECT_EQ(line, records[3].mObject);
+    EXPECT_EQ(0, records[3].mOffset);
+    EXPECT_EQ(ExportPlan::npos, records[3].mAttrState);
+    EXPECT_EQ(light, records[4].mObject);
+    EXPECT_EQ(0, records[4].mOffset);
+    EXPECT_EQ(m2, records[5].mObject);
+    EXPECT_EQ(m1->pFaces.size(), records[5].mOffset);
+    EXPECT_EQ(1, records[5].mAttrState);
+    EXPECT_EQ(dummy, records[6].mObject);
+
+    EXPECT_EQ(ExportPlan::RECORD_ANIM_END, records[7].mType);
+    EXPECT_EQ(&child, records[7].mTransform);
+    EXPECT_EQ(ExportPlan::RECORD_SECTION_END, records[8].mType);
+    EXPECT_EQ(m3, records[9].mObject);
+    EXPECT_EQ(m1->pFaces.size() * 2, records[9].mOffset);
+    EXPECT_EQ(0, records[9].mAttrState);
+    EXPECT_EQ(ExportPlan::RECORD_SECTION_END, records[10].mType);
+
+    //-------------------------------------------------------------------------
+
+    ASSERT_EQ(3, plan.meshes().size());
+    EXPECT_EQ(2, plan.lodMeshesCount());
+    EXPECT_EQ(m3, plan.meshes()[2]);
+    EXPECT_EQ(2, plan.attrStates().size());
+    EXPECT_EQ(1, plan.lines().size());
+    EXPECT_EQ(1, plan.lightPoints().size());
+    EXPECT_EQ(m1->pVertices.size() * 3, plan.meshVerticesCount());
+    EXPECT_EQ(m1->pFaces.size() * 3, plan.meshFacesCount());
+    EXPECT_EQ(3, plan.lineVerticesCount());
+}
+
+TEST(ExportPlan, reorder_by_attributes) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    const auto addMesh = [](Transform & transform, const char * name, const float shiny, const bool blended) {
+        auto * mesh = TestUtilsObjMesh::createPyramidTestMesh(name);
+        mesh->pAttr.setShiny(AttrShiny(shiny));
+        if (!blended) {
+            mesh->pAttr.setBlend(AttrBlend(AttrBlend::no_blend, 0.5f));
+        }
+        transform.addObject(mesh);
+        return mesh;
+    };
+
+    auto * a1 = addMesh(lod.transform(), "a1", 0.1f, false);
+    auto * t1 = addMesh(lod.transform(), "t1", 0.1f, true);
+    auto * b1 = addMesh(lod.transform(), "b1", 0.2f, false);
+    auto * t2 = addMesh(lod.transform(), "t2", 0.2f, true);
+    auto * a2 = addMesh(lod.transform(), "a2", 0.1f, false);
+    auto * b2 = addMesh(lod.transform(), "b2", 0.2f, false);
+    // the custom data splits the groups
+    auto * c1 = addMesh(lod.transform(), "c1", 0.1f, false);
+    c1->addDataBefore("## custom");
+    auto * a3 = addMesh(lod.transform(), "a3", 0.2f, false);
+    auto * a4 = addMesh(lod.transform(), "a4", 0.1f, false);
+
+    // the meshes of the animated transform and its not animated children
+    // are reordered inside the animation, the nested animation splits them.
+    Transform & anim = lod.transform().newChild("anim");
+    anim.pAnimTrans.emplace_back(AnimTrans());
+    anim.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(1.0f, 1.0f, 1.0f, 1.0f));
+    anim.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(2.0f, 2.0f, 2.0f, 2.0f));
+    auto * n1 = addMesh(anim, "n1", 0.1f, false);
+    auto * n2 = addMesh(anim, "n2", 0.2f, false);
+    Transform & still = anim.newChild("still");
+    auto * n3 = addMesh(still, "n3", 0.1f, false);
+    Transform & nested = still.newChild("nested");
+    nested.pAnimTrans = anim.pAnimTrans;
+    auto * k1 = addMesh(nested, "k1", 0.2f, false);
+    auto * k2 = addMesh(nested, "k2", 0.1f, false);
+    auto * k3 = addMesh(nested, "k3", 0.2f, false);
+
+    ExportPlan plan;
+    plan.build(main);
+    const std::size_t facesOffset = plan.records()[5].mOffset;
+    plan.reorderByAttributes();
+
+    std::vector<const ObjAbstract *> objects;
+    for (const auto & record : plan.records()) {
+        if (record.mType == ExportPlan::RECORD_OBJECT) {
+            objects.emplace_back(record.mObject);
+        }
+    }
+    const std::vector<const ObjAbstract *> expected = {a1, a2, b1, b2, t1, t2, c1, a3, a4, n1, n3, n2, k1, k3, k2};
+    EXPECT_EQ(expected, objects);
+    // the geometry isn't changed
+    EXPECT_EQ(a2, plan.records()[2].mObject);
+    EXPECT_EQ(facesOffset, plan.records()[2].mOffset);
+}
+
+TEST(ExportPlan, range_records_count) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    const auto addMesh = [&](const char * name, const float shiny) {
+        auto * mesh = TestUtilsObjMesh::createPyramidTestMesh(name);
+        mesh->pAttr.setBlend(AttrBlend(AttrBlend::no_blend, 0.5f));
+        mesh->pAttr.setShiny(AttrShiny(shiny));
+        lod.transform().addObject(mesh);
+        return mesh;
+    };
+    addMesh("m1", 0.1f);
+    addMesh("m2", 0.1f);
+    addMesh("m3", 0.2f);
+    addMesh("m4", 0.1f);
+    addMesh("m5", 0.1f)->addDataBefore("## custom");
+    for (std::size_t i = 0; i < 3; ++i) {
+        lod.transform().addObject(new ObjLightPoint());
+    }
+
+    ExportPlan plan;
+    plan.build(main);
+    ASSERT_EQ(11, plan.records().size());
+    EXPECT_EQ(1, plan.rangeRecordsCount(0)); // LOD
+    EXPECT_EQ(2, plan.rangeRecordsCount(1));
+    EXPECT_EQ(1, plan.rangeRecordsCount(2));
+    EXPECT_EQ(1, plan.rangeRecordsCount(3));
+    EXPECT_EQ(1, plan.rangeRecordsCount(4)); // next one has the custom data
+    EXPECT_EQ(1, plan.rangeRecordsCount(5));
+    EXPECT_EQ(3, plan.rangeRecordsCount(6));
+    EXPECT_EQ(2, plan.rangeRecordsCount(7));
+    EXPECT_EQ(1, plan.rangeRecordsCount(9)); // section end
+
+    // m1, m2, m4, m3 - the faces of m4 aren't contiguous with m2 ones
+    plan.reorderByAttributes();
+    EXPECT_EQ(2, plan.rangeRecordsCount(1));
+    EXPECT_EQ(1, plan.rangeRecordsCount(3));
+}
+
+TEST(ExportPlan, static_transforms_are_collapsed) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    Transform & root = lod.transform();
+    const auto addAnim = [](Transform & transform) {
+        transform.pAnimTrans.emplace_back(AnimTrans());
+        transform.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(1.0f, 1.0f, 1.0f, 1.0f));
+        transform.pAnimTrans.back().pKeys.emplace_back(AnimTransKey(2.0f, 2.0f, 2.0f, 2.0f));
+    };
+    const auto addMesh = [](Transform & transform, const float shiny) {
+        auto * mesh = TestUtilsObjMesh::createPyramidTestMesh("m");
+        mesh->pAttr.setBlend(AttrBlend(AttrBlend::no_blend, 0.5f));
+        mesh->pAttr.setShiny(AttrShiny(shiny));
+        transform.addObject(mesh);
+        return mesh;
+    };
+
+    // root <- s1 <- s2 (m1)
+    //      <- s3 (m2)
+    //      <- s4 (m3)
+    //      <- a1 <- s5 (m4)
+    //            <- a2 <- a3
+    auto * m1 = addMesh(root.newChild("s1").newChild("s2"), 0.1f);
+    auto * m2 = addMesh(root.newChild("s3"), 0.2f);
+    auto * m3 = addMesh(root.newChild("s4"), 0.1f);
+    Transform & a1 = root.newChild("a1");
+    addAnim(a1);
+    auto * m4 = addMesh(a1.newChild("s5"), 0.1f);
+    Transform & a2 = a1.newChild("a2");
+    addAnim(a2);
+    addAnim(a2.newChild("a3"));
+
+    ExportPlan plan;
+    plan.build(main);
+    const auto & records = plan.records();
+    ASSERT_EQ(13, records.size());
+    EXPECT_EQ(&root, records[1].mTransform);
+    EXPECT_EQ(&root, records[2].mTransform);
+    EXPECT_EQ(&root, records[3].mTransform);
+    EXPECT_EQ(m4, records[5].mObject);
+    EXPECT_EQ(&a1, records[5].mTransform);
+
+    // the meshes of the collapsed transforms are grouped
+    plan.reorderByAttributes();
+    EXPECT_EQ(m1, records[1].mObject);
+    EXPECT_EQ(m3, records[2].mObject);
+    EXPECT_EQ(m2, records[3].mObject);
+
+    // a2 and a3 haven't objects
+    EXPECT_EQ(2, plan.removeEmptyAnimations());
+    ASSERT_EQ(9, records.size());
+    EXPECT_EQ(ExportPlan::RECORD_ANIM_BEGIN, records[4].mType);
+    EXPECT_EQ(m4, records[5].mObject);
+    EXPECT_EQ(ExportPlan::RECORD_ANIM_END, records[6].mType);
+    EXPECT_EQ(&a1, records[6].mTransform);
+    EXPECT_EQ(ExportPlan::RECORD_SECTION_END, records[7].mType);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,163 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/manipulators/AttrManipCmd.h"
+#include "xpln/utils/DatarefRegistry.h"
+#include "xpln/utils/CommandRegistry.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking the datarefs and commands
+ * which are collected and resolved before printing the object.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static Transform & fillMain(ObjMain & main, const char * transDrf, const char * rotateDrf, const char * lightLevelDrf, const char * cmd) {
+    Transform & tr = TestUtilsObjMesh::createAnimatedScene(main, transDrf);
+    TestUtils::createTestAnimRotate(tr.pAnimRotate, Point3(0.0f, 1.0f, 0.0f), rotateDrf);
+
+    auto * mesh = static_cast<ObjMesh*>(tr.objList().front().get());
+    mesh->pAttr.setLightLevel(AttrLightLevel(0.0f, 1.0f, lightLevelDrf));
+    auto * manip = new AttrManipCmd();
+    manip->setCmd(cmd);
+    mesh->pAttr.setManipulator(manip);
+    return tr;
+}
+
+static DatarefRegistry::Ptr datarefs() {
+    std::stringstream stream;
+    stream << " first line " << std::endl;
+    stream << R"(000041:sim/test/value41)" << std::endl;
+    stream << R"(000042:sim/test/value42)" << std::endl;
+    return DatarefRegistry::loadStream(stream);
+}
+
+static CommandRegistry::Ptr commands() {
+    std::stringstream stream;
+    stream << R"(000005:sim/test/command5)" << std::endl;
+    return CommandRegistry::loadStream(stream);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ExportReferences, used_references) {
+    std::string result;
+    ObjMain main;
+    fillMain(main, "41", "sim/test/plain", "42", "5");
+    ExportContext context;
+    context.setDatarefRegistry(datarefs());
+    context.setCommandRegistry(commands());
+    context.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(context));
+
+    ASSERT_EQ(3, context.usedDatarefs().size());
+    EXPECT_EQ(1, context.usedDatarefs().count("sim/test/value41"));
+    EXPECT_EQ(1, context.usedDatarefs().count("sim/test/value42"));
+    EXPECT_EQ(1, context.usedDatarefs().count("sim/test/plain"));
+    ASSERT_EQ(1, context.usedCommands().size());
+    EXPECT_EQ(1, context.usedCommands().count("sim/test/command5"));
+
+    EXPECT_NE(std::string::npos, result.find("sim/test/value41"));
+    EXPECT_NE(std::string::npos, result.find("sim/test/value42"));
+    EXPECT_NE(std::string::npos, result.find("sim/test/command5"));
+}
+
+TEST(ExportReferences, missing_ids) {
+    std::string result;
+    ObjMain main;
+    fillMain(main, "43", "44", "42", "6");
+    ExportContext context;
+    context.setDatarefRegistry(datarefs());
+    context.setCommandRegistry(commands());
+    context.setOutputString(result);
+    ASSERT_FALSE(main.exportObj(context));
+    // nothing is printed because the ids are validated before printing.
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(ExportReferences, reduced_animation) {
+    std::string result;
+    ObjMain main;
+    Transform & tr = fillMain(main, "41", "sim/test/plain", "42", "5");
+    TestUtils::createTestAnimTranslate(tr.pAnimTrans, AnimTransKey(Point3(0.0f), 0.0f), AnimTransKey(Point3(0.0f), 1.0f), TMatrix(), "43");
+    TestUtils::createTestAnimRotate(tr.pAnimRotate, Point3(0.0f, 1.0f, 0.0f), "44");
+    tr.pAnimRotate.back().pKeys[0].pAngleDegrees = 0.0f;
+    tr.pAnimRotate.back().pKeys[1].pAngleDegrees = 0.0f;
+
+    ExportContext context;
+    context.setDatarefRegistry(datarefs());
+    context.setCommandRegistry(commands());
+    context.setOutputString(result);
+    // the ids of the zero animations are missing, but those animations aren't printed.
+    main.pExportOptions.enable(XOBJ_EXP_REDUCE_KEYFRAMES);
+    ASSERT_TRUE(main.exportObj(context));
+    EXPECT_EQ(2, context.statistic().pOptAnimRemovedCount);
+
+    ASSERT_EQ(3, context.usedDatarefs().size());
+    EXPECT_EQ(0, context.usedDatarefs().count("43"));
+    EXPECT_EQ(0, context.usedDatarefs().count("44"));
+
+    // without the reduction the zero animations are printed, so their ids are required.
+    result.clear();
+    main.pExportOptions.disable(XOBJ_EXP_REDUCE_KEYFRAMES);
+    ASSERT_FALSE(main.exportObj(context));
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(ExportReferences, without_files) {
+    std::string result;
+    ObjMain main;
+    fillMain(main, "sim/test/a", "sim/test/b", "sim/test/c", "5");
+    ExportContext context;
+    context.setOutputString(result);
+    ASSERT_FALSE(main.exportObj(context));
+    ASSERT_TRUE(result.empty());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,110 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+static double phasesWallSec(const IOPhaseTime & time) {
+    return time.pWallSec;
+}
+
+template<typename... Times>
+static double phasesWallSec(const IOPhaseTime & time, const Times & ... times) {
+    return time.pWallSec + phasesWallSec(times...);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(IOStatistic, export_phases) {
+    const auto fileName = XOBJ_PATH("IOStatistic-export_phases.obj");
+    ObjMain main;
+    main.pExportOptions.enable(XOBJ_EXP_CHECK_INSTANCE);
+    main.addLod().transform().addObject(TestUtilsObjMesh::createGridMesh("grid", 50));
+
+    ExportContext context(fileName);
+    context.setOutputBufferSize(4096);
+    ASSERT_TRUE(main.exportObj(context));
+    const IOStatistic & stat = context.statistic();
+
+    EXPECT_EQ(TestUtils::readFileContent(fileName).size(), stat.pBytesWritten);
+    EXPECT_LE(std::size_t(4096), stat.pPeakBufferBytes);
+    EXPECT_LT(0.0, stat.pTimeTotal.pWallSec);
+    EXPECT_LT(0.0, stat.pTimeVertices.pWallSec);
+    EXPECT_LE(0.0, stat.pTimeTotal.pCpuSec);
+    // the phases are sequential parts of the whole export
+    EXPECT_GE(stat.pTimeTotal.pWallSec,
+              phasesWallSec(stat.pTimeLodsValidation, stat.pTimeInstancing, stat.pTimePreparing,
+                            stat.pTimeTransformation, stat.pTimeCounting, stat.pTimeVertices,
+                            stat.pTimeIndices, stat.pTimeObjects));
+    // import phases aren't touched
+    EXPECT_EQ(0.0, stat.pTimeFileLoad.pWallSec);
+    EXPECT_EQ(0, stat.pBytesRead);
+}
+
+TEST(IOStatistic, import_phases) {
+    const auto fileName = XOBJ_PATH("IOStatistic-import_phases.obj");
+    ObjMain main;
+    auto * grid = TestUtilsObjMesh::createGridMesh("grid", 50);
+    const std::size_t verticesCount = grid->pVertices.size();
+    const std::size_t facesCount = grid->pFaces.size();
+    main.addLod().transform().addObject(grid);
+    ExportContext expContext(fileName);
+    ASSERT_TRUE(main.exportObj(expContext));
+
+    ObjMain inObj;
+    ImportContext context(fileName);
+    ASSERT_TRUE(inObj.importObj(context));
+    const IOStatistic & stat = context.statistic();
+
+    const std::size_t fileSize = TestUtils::readFileContent(fileName).size();
+    EXPECT_EQ(fileSize, stat.pBytesRead);
+    EXPECT_EQ(fileSize, stat.pPeakBufferBytes);
+    EXPECT_EQ(verticesCount, stat.pMeshVerticesCount);
+    EXPECT_EQ(facesCount, stat.pMeshFacesCount);
+    EXPECT_LT(0.0, stat.pTimeTotal.pWallSec);
+    EXPECT_LT(0.0, stat.pTimeGeometry.pWallSec);
+    EXPECT_GE(stat.pTimeTotal.pWallSec,
+              phasesWallSec(stat.pTimeFileLoad, stat.pTimeHeader, stat.pTimeGeometry, stat.pTimeInterpretation));
+    EXPECT_EQ(0, stat.pBytesWritten);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,119 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/IOStatistic.h"
+#include "xpln/obj/ExportOptions.h"
+#include "io/writer/ObjWriteGeometry.h"
+#include "io/writer/ExportPlan.h"
+#include "../TestWriter.h"
+#include "../MockIWriter.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(IdxWriting, groups) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    lod.transform().addObject(TestUtilsObjMesh::createPyramidTestMesh("m1"));
+    lod.transform().addObject(TestUtilsObjMesh::createPyramidTestMesh("m2"));
+
+    ExportOptions options;
+    IOStatistic stat;
+    stat.pMeshFacesCount = 6;
+    ObjWriteGeometry geometry(&options, &stat);
+    TestWriter writer;
+    ExportPlan plan;
+    plan.build(main);
+    geometry.printMeshFaces(writer, plan);
+
+    EXPECT_EQ(std::string("\n"
+                          "IDX10 2 1 0 2 3 1 2 0 3 6 \n"
+                          "IDX 5 \n"
+                          "IDX 4 \n"
+                          "IDX 6 \n"
+                          "IDX 7 \n"
+                          "IDX 5 \n"
+                          "IDX 6 \n"
+                          "IDX 4 \n"
+                          "IDX 7 \n"), writer.mResult);
+}
+
+TEST(IdxWriting, big_mesh_is_printed_by_chunks) {
+    ObjMain main;
+    ObjLodGroup & lod = main.addLod();
+    auto * mesh = TestUtilsObjMesh::createGridMesh("m1", 300);
+    lod.transform().addObject(TestUtilsObjMesh::createPyramidTestMesh("m0"));
+    lod.transform().addObject(mesh);
+
+    // every index is printed with the offset of the first mesh's vertices.
+    std::vector<std::size_t> indices = {2, 1, 0, 2, 3, 1, 2, 0, 3};
+    for (const auto & f : mesh->pFaces) {
+        indices.emplace_back(f.pV0 + 4);
+        indices.emplace_back(f.pV1 + 4);
+        indices.emplace_back(f.pV2 + 4);
+    }
+    std::string expected("\n");
+    std::size_t i = 0;
+    for (; i + 10 <= indices.size(); i += 10) {
+        expected.append("IDX10 ");
+        for (std::size_t j = i; j < i + 10; ++j) {
+            expected.append(std::to_string(indices[j])).append(" ");
+        }
+        expected.append("\n");
+    }
+    for (; i < indices.size(); ++i) {
+        expected.append("IDX ").append(std::to_string(indices[i])).append(" \n");
+    }
+
+    ExportOptions options;
+    IOStatistic stat;
+    stat.pMeshFacesCount = indices.size() / 3;
+    ObjWriteGeometry geometry(&options, &stat);
+    ExportPlan plan;
+    plan.build(main);
+    TestWriter writer;
+    geometry.printMeshFaces(writer, plan);
+    EXPECT_EQ(expected, writer.mResult);
+
+    // the empty line and several chunks
+    MockWriter mock;
+    EXPECT_CALL(mock, printLine(testing::_)).Times(testing::AtLeast(3));
+    geometry.printMeshFaces(mock, plan);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,239 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "../TestUtils.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking how the imported meshes
+ * take their vertices from the global vertex array.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static std::string header(const std::size_t vertices, const std::size_t indices) {
+    return "I\n800\nOBJ\n\nPOINT_COUNTS " + std::to_string(vertices) + " 0 0 " + std::to_string(indices) + "\n\n";
+}
+
+static std::string vertex(const int val) {
+    const std::string v = std::to_string(val);
+    return "VT " + v + " " + v + " " + v + "  0 1 0  0 0\n";
+}
+
+static ObjMesh * meshAt(ObjMain & main, const std::size_t index) {
+    const auto & objects = main.lods().at(0)->transform().objList();
+    return static_cast<ObjMesh *>(objects.at(index).get());
+}
+
+/*
+ * The second mesh doesn't use the vertex 4.
+ */
+static void writeTwoMeshes(const Path & fileName) {
+    std::string content = header(6, 9);
+    for (int i = 0; i < 6; ++i) {
+        content.append(vertex(i));
+    }
+    content.append("IDX 2\nIDX 1\nIDX 0\nIDX 3\nIDX 5\nIDX 3\nIDX 5\nIDX 3\nIDX 5\n\n");
+    content.append("TRIS 0 3\nTRIS 3 6\n");
+    TestUtils::writeFileContent(fileName, content);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ImportGeometry, meshes_take_vertex_ranges) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-vertex_ranges.obj");
+    writeTwoMeshes(fileName);
+    //-----------------------------
+    ObjMain main;
+    ImportContext context(fileName);
+    ASSERT_TRUE(main.importObj(context));
+    ASSERT_EQ(1, main.lods().size());
+    ASSERT_EQ(2, main.lods().at(0)->transform().objList().size());
+
+    const ObjMesh * mesh1 = meshAt(main, 0);
+    ASSERT_EQ(3, mesh1->pVertices.size());
+    ASSERT_EQ(1, mesh1->pFaces.size());
+    EXPECT_EQ(2, mesh1->pFaces[0].pV0);
+    EXPECT_EQ(1, mesh1->pFaces[0].pV1);
+    EXPECT_EQ(0, mesh1->pFaces[0].pV2);
+    EXPECT_EQ(Point3(2.0f), mesh1->pVertices[2].pPosition);
+
+    const ObjMesh * mesh2 = meshAt(main, 1);
+    ASSERT_EQ(3, mesh2->pVertices.size());
+    ASSERT_EQ(2, mesh2->pFaces.size());
+    EXPECT_EQ(0, mesh2->pFaces[0].pV0);
+    EXPECT_EQ(2, mesh2->pFaces[0].pV1);
+    EXPECT_EQ(Point3(3.0f), mesh2->pVertices[0].pPosition);
+    EXPECT_EQ(Point3(4.0f), mesh2->pVertices[1].pPosition);
+    EXPECT_EQ(Point3(5.0f), mesh2->pVertices[2].pPosition);
+}
+
+TEST(ImportGeometry, index_out_of_vertex_range) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-out_of_range.obj");
+    std::string content = header(3, 3);
+    for (int i = 0; i < 3; ++i) {
+        content.append(vertex(i));
+    }
+    content.append("IDX 0\nIDX 1\nIDX 3\n\nTRIS 0 3\n");
+    TestUtils::writeFileContent(fileName, content);
+    //-----------------------------
+    ObjMain main;
+    ImportContext context(fileName);
+    ASSERT_FALSE(main.importObj(context));
+}
+
+TEST(ImportGeometry, tris_out_of_index_range) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-tris_out_of_range.obj");
+    for (const char * tris : {"TRIS -1 3\n", "TRIS -4 6\n", "TRIS 3 6\n"}) {
+        std::string content = header(3, 6);
+        for (int i = 0; i < 3; ++i) {
+            content.append(vertex(i));
+        }
+        content.append("IDX 0\nIDX 1\nIDX 2\nIDX 2\nIDX 1\nIDX 0\n\n").append(tris);
+        TestUtils::writeFileContent(fileName, content);
+        //-----------------------------
+        ObjMain main;
+        ImportContext context(fileName);
+        ASSERT_FALSE(main.importObj(context)) << tris;
+    }
+}
+
+TEST(ImportGeometry, meshes_share_vertices) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-shared_vertices.obj");
+    writeTwoMeshes(fileName);
+    //-----------------------------
+    ObjMain main;
+    ImportContext context(fileName);
+    context.setSharedMeshVertices(true);
+    ASSERT_TRUE(main.importObj(context));
+    ASSERT_EQ(2, main.lods().at(0)->transform().objList().size());
+
+    const ObjMesh * mesh1 = meshAt(main, 0);
+    const ObjMesh * mesh2 = meshAt(main, 1);
+    ASSERT_TRUE(mesh1->hasSharedVertices());
+    ASSERT_TRUE(mesh2->hasSharedVertices());
+    EXPECT_EQ(mesh1->sharedVertices(), mesh2->sharedVertices());
+    EXPECT_EQ(6, mesh1->sharedVertices()->size());
+    EXPECT_TRUE(mesh1->pVertices.empty());
+    EXPECT_TRUE(mesh2->pVertices.empty());
+
+    EXPECT_EQ(0, mesh1->sharedVerticesOffset());
+    ASSERT_EQ(3, mesh1->verticesCount());
+    EXPECT_EQ(2, mesh1->pFaces[0].pV0);
+    EXPECT_EQ(Point3(2.0f), mesh1->vertices()[2].pPosition);
+
+    EXPECT_EQ(3, mesh2->sharedVerticesOffset());
+    ASSERT_EQ(3, mesh2->verticesCount());
+    EXPECT_EQ(0, mesh2->pFaces[0].pV0);
+    EXPECT_EQ(2, mesh2->pFaces[0].pV1);
+    EXPECT_EQ(Point3(3.0f), mesh2->vertices()[0].pPosition);
+    EXPECT_EQ(Point3(4.0f), mesh2->vertices()[1].pPosition);
+    EXPECT_EQ(Point3(5.0f), mesh2->vertices()[2].pPosition);
+
+    const std::unique_ptr<ObjAbstract> copy(mesh2->clone());
+    const auto * meshCopy = static_cast<const ObjMesh *>(copy.get());
+    EXPECT_EQ(mesh2->sharedVertices(), meshCopy->sharedVertices());
+    EXPECT_EQ(mesh2->vertices(), meshCopy->vertices());
+}
+
+TEST(ImportGeometry, shared_vertices_copy_on_write) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-shared_vertices_cow.obj");
+    writeTwoMeshes(fileName);
+    //-----------------------------
+    ObjMain main;
+    ImportContext context(fileName);
+    context.setSharedMeshVertices(true);
+    ASSERT_TRUE(main.importObj(context));
+
+    ObjMesh * mesh1 = meshAt(main, 0);
+    ObjMesh * mesh2 = meshAt(main, 1);
+
+    TMatrix identity;
+    mesh1->applyTransform(identity);
+    EXPECT_TRUE(mesh1->hasSharedVertices());
+
+    TMatrix tm;
+    tm.setPosition(Point3(10.0f, 0.0f, 0.0f));
+    mesh1->applyTransform(tm);
+    EXPECT_FALSE(mesh1->hasSharedVertices());
+    ASSERT_EQ(3, mesh1->pVertices.size());
+    EXPECT_EQ(mesh1->pVertices.data(), mesh1->vertices());
+    EXPECT_EQ(Point3(12.0f, 2.0f, 2.0f), mesh1->pVertices[2].pPosition);
+
+    mesh2->flipNormals();
+    EXPECT_FALSE(mesh2->hasSharedVertices());
+    ASSERT_EQ(3, mesh2->pVertices.size());
+    EXPECT_EQ(Point3(3.0f), mesh2->pVertices[0].pPosition);
+    EXPECT_EQ(Point3(0.0f, -1.0f, 0.0f), mesh2->pVertices[0].pNormal);
+}
+
+TEST(ImportGeometry, shared_vertices_export) {
+    const auto fileName = XOBJ_PATH("ImportGeometry-shared_vertices_export.obj");
+    writeTwoMeshes(fileName);
+    const auto ownFileName = XOBJ_PATH("ImportGeometry-shared_vertices_export-own.obj");
+    const auto sharedFileName = XOBJ_PATH("ImportGeometry-shared_vertices_export-shared.obj");
+    //-----------------------------
+    ObjMain ownMain;
+    ImportContext ownContext(fileName);
+    ASSERT_TRUE(ownMain.importObj(ownContext));
+    TestUtils::setTestExportOptions(ownMain);
+    ExportContext ownExpContext(ownFileName);
+    ASSERT_TRUE(ownMain.exportObj(ownExpContext));
+
+    ObjMain sharedMain;
+    ImportContext sharedContext(fileName);
+    sharedContext.setSharedMeshVertices(true);
+    ASSERT_TRUE(sharedMain.importObj(sharedContext));
+    TestUtils::setTestExportOptions(sharedMain);
+    ExportContext sharedExpContext(sharedFileName);
+    ASSERT_TRUE(sharedMain.exportObj(sharedExpContext));
+    //-----------------------------
+    const std::string ownContent = TestUtils::readFileContent(ownFileName);
+    ASSERT_FALSE(ownContent.empty());
+    EXPECT_EQ(ownContent, TestUtils::readFileContent(sharedFileName));
+    EXPECT_TRUE(meshAt(sharedMain, 0)->hasSharedVertices());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
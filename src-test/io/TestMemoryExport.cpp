@@ -0,0 +1,164 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "io/writer/Writer.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking exporting into the memory targets.
+ * The result must be the same as the file content.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static std::string exportToFile() {
+    const auto fileName = XOBJ_PATH("MemoryExport.obj");
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context(fileName);
+    EXPECT_TRUE(main.exportObj(context));
+    return TestUtils::readFileContent(fileName);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(MemoryExport, string) {
+    const std::string expected = exportToFile();
+    ASSERT_FALSE(expected.empty());
+
+    std::string result;
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context;
+    context.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_EQ(expected, result);
+}
+
+TEST(MemoryExport, vector) {
+    const std::string expected = exportToFile();
+
+    std::vector<char> result;
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context;
+    context.setOutputVector(result);
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_EQ(expected, std::string(result.begin(), result.end()));
+}
+
+TEST(MemoryExport, stream) {
+    const std::string expected = exportToFile();
+
+    std::stringstream result;
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context;
+    context.setOutputStream(result);
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_EQ(expected, result.str());
+}
+
+TEST(MemoryExport, callback_chunks) {
+    const std::string expected = exportToFile();
+
+    std::string result;
+    std::size_t chunks = 0;
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context;
+    context.setOutputBufferSize(1024);
+    context.setOutputCallback([&](const char * data, const std::size_t size) {
+        result.append(data, size);
+        ++chunks;
+        return true;
+    });
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_EQ(expected, result);
+    ASSERT_LT(1, chunks);
+}
+
+TEST(MemoryExport, callback_error) {
+    ObjMain main;
+    TestUtilsObjMesh::createTwoLodsScene(main, 40);
+    ExportContext context;
+    context.setOutputBufferSize(1024);
+    std::size_t calls = 0;
+    context.setOutputCallback([&](const char *, std::size_t) {
+        ++calls;
+        return false;
+    });
+    ASSERT_FALSE(main.exportObj(context));
+    ASSERT_EQ(1, calls);
+}
+
+TEST(MemoryExport, not_closed_writer_is_discarded) {
+    std::string result;
+    ExportContext context;
+    context.setOutputString(result);
+    {
+        Writer writer;
+        writer.setBufferSize(8);
+        writer.openOutput(context.outputCallback());
+        writer.printLine("first line");
+        writer.printLine("second");
+        // the failed export doesn't close the writer.
+    }
+    ASSERT_EQ("first line\n", result);
+    //-----------------------------
+    result.clear();
+    {
+        Writer writer;
+        writer.setBufferSize(8);
+        writer.openOutput(context.outputCallback());
+        writer.printLine("first line");
+        writer.printLine("second");
+        ASSERT_TRUE(writer.closeFile());
+    }
+    ASSERT_EQ("first line\nsecond\n", result);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,250 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "xpln/obj/MeshVertex.h"
+#include "converters/ObjString.h"
+#include "io/reader/NumberParse.h"
+#include "../TestWriter.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking the float parsing gives
+ * the same bits as strtof does. The benchmark is disabled by default,
+ * use --gtest_also_run_disabled_tests to run it.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static const std::uint8_t * toBytes(const std::string & str) {
+    return reinterpret_cast<const std::uint8_t *>(str.data());
+}
+
+static float parse(const std::string & str, std::size_t * outLength = nullptr) {
+    float val = -1.0f;
+    const std::uint8_t * end = NumberParse::parseFloat(toBytes(str), toBytes(str) + str.size(), val);
+    if (outLength) {
+        *outLength = std::size_t(end - toBytes(str));
+    }
+    return val;
+}
+
+static std::uint32_t bitsOf(const float val) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
+
+static ::testing::AssertionResult sameAsStrtof(const std::string & str) {
+    const float expected = std::strtof(str.c_str(), nullptr);
+    const float actual = parse(str);
+    if (bitsOf(expected) == bitsOf(actual)) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure() << "<" << str << "> is parsed as " << actual << " expected " << expected;
+}
+
+/*! \details xorshift, so the values are the same on all compilers. */
+static std::uint64_t nextRandom(std::uint64_t & state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(NumberParse, values) {
+    for (const char * str : {
+             "0", "-0", "+0", "0.0", "1", "-1", "1.5", "+2", ".5", "5.", "-.25", "0.00001",
+             "123.45678", "-1234.56789", "98765.43210", "16777217", "0.1", "0.3", "3.14159265358979",
+             "1e3", "1.5E-2", "-2.5e+10", "1e-30", "3.4028235e38", "1.17549435e-38",
+             "0.000000000000000000000000000000000000000000001", "1e-46", "1e39", "-1e39",
+             "123456789012345678901234567890", "1.000000059604644775390625", "1.00000005960464477539062500001"
+         }) {
+        EXPECT_TRUE(sameAsStrtof(str));
+    }
+    EXPECT_TRUE(std::signbit(parse("-0.0")));
+    EXPECT_FALSE(std::signbit(parse("0.0")));
+}
+
+TEST(NumberParse, end_of_number) {
+    std::size_t length = 0;
+    EXPECT_EQ(1.5f, parse("1.5abc", &length));
+    EXPECT_EQ(3u, length);
+    EXPECT_EQ(1.0f, parse("1e", &length));
+    EXPECT_EQ(1u, length);
+    EXPECT_EQ(1.0f, parse("1e+ 2", &length));
+    EXPECT_EQ(1u, length);
+    EXPECT_EQ(100.0f, parse("1e2 3", &length));
+    EXPECT_EQ(3u, length);
+    EXPECT_EQ(0.0f, parse("abc", &length));
+    EXPECT_EQ(0u, length);
+    EXPECT_EQ(0.0f, parse("", &length));
+    EXPECT_EQ(0u, length);
+    EXPECT_EQ(0.25f, parse("0.25000000000 1", &length));
+    EXPECT_EQ(13u, length);
+}
+
+TEST(NumberParse, random_values) {
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    char buffer[128];
+    for (std::size_t i = 0; i < 200000; ++i) {
+        const std::uint64_t rnd = nextRandom(state);
+        // random bits of the normal floats
+        std::uint32_t bits = std::uint32_t(rnd);
+        if (((bits >> 23) & 0xFF) == 0xFF) {
+            bits &= ~(std::uint32_t(1) << 30);
+        }
+        float val;
+        std::memcpy(&val, &bits, sizeof(val));
+        std::snprintf(buffer, sizeof(buffer), "%.9g", double(val));
+        ASSERT_TRUE(sameAsStrtof(buffer));
+        ASSERT_EQ(bitsOf(val), bitsOf(parse(buffer)));
+        // random digits with the exponent
+        std::snprintf(buffer, sizeof(buffer), "%llu.%llue%d",
+                      static_cast<unsigned long long>(rnd >> 40), static_cast<unsigned long long>(rnd % 100000000ull),
+                      int(rnd % 90) - 45);
+        ASSERT_TRUE(sameAsStrtof(buffer));
+    }
+}
+
+TEST(NumberParse, round_trip_with_vertex_printing) {
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    const auto randomFloat = [&](const float range) {
+        return (float(nextRandom(state) % 2000001) / 1000000.0f - 1.0f) * range;
+    };
+    TestWriter writer(false);
+    for (std::size_t i = 0; i < 20000; ++i) {
+        const MeshVertex vertex(Point3(randomFloat(10000.0f), randomFloat(100.0f), randomFloat(1.0f)),
+                                Point3(randomFloat(1.0f), randomFloat(1.0f), randomFloat(1.0f)),
+                                Point2(randomFloat(1.0f), randomFloat(1.0f)));
+        printObj(vertex, writer.clear(), false);
+        const std::string & line = writer.mResult;
+        ASSERT_EQ(0u, line.compare(0, 3, "VT "));
+
+        const Point3 normal = vertex.pNormal.normalized();
+        const float original[8] = {
+            vertex.pPosition.x, vertex.pPosition.y, vertex.pPosition.z,
+            normal.x, normal.y, normal.z,
+            vertex.pTexture.x, vertex.pTexture.y
+        };
+        const std::uint8_t * ptr = toBytes(line) + 3;
+        const std::uint8_t * end = toBytes(line) + line.size();
+        for (const float orig : original) {
+            while (ptr != end && *ptr == ' ') {
+                ++ptr;
+            }
+            const std::uint8_t * start = ptr;
+            float val = 0.0f;
+            ptr = NumberParse::parseFloat(ptr, end, val);
+            const std::string token(start, ptr);
+            ASSERT_TRUE(sameAsStrtof(token));
+            ASSERT_NEAR(orig, val, 0.5e-5 + std::abs(orig) * 1e-6) << token;
+        }
+        ASSERT_EQ(end, ptr);
+    }
+}
+
+TEST(NumberParse, DISABLED_benchmark) {
+    TestWriter writer;
+    for (std::size_t i = 0; i < 1000000; ++i) {
+        const float v = float(i % 1000);
+        printObj(MeshVertex(Point3(v * 0.37f, -v * 1.91f, v * 13.03f), Point3(0.2f, 0.5f, 0.7f),
+                            Point2(v * 0.001f, 1.0f - v * 0.001f)), writer, false);
+    }
+    const std::string & text = writer.mResult;
+
+    const auto measure = [&](const char * name, float (*parser)(const char *, const char *, const char **)) {
+        const char * ptr = text.data();
+        const char * end = ptr + text.size();
+        float sum = 0.0f;
+        const auto start = std::chrono::steady_clock::now();
+        while (ptr != end) {
+            if (*ptr == '-' || (*ptr >= '0' && *ptr <= '9')) {
+                sum += parser(ptr, end, &ptr);
+            }
+            else {
+                ++ptr;
+            }
+        }
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << seconds.count() << " s, sum " << sum << std::endl;
+    };
+
+    measure("NumberParse", [](const char * str, const char * end, const char ** outEnd) {
+        float val;
+        *outEnd = reinterpret_cast<const char *>(NumberParse::parseFloat(reinterpret_cast<const std::uint8_t *>(str),
+                                                                         reinterpret_cast<const std::uint8_t *>(end), val));
+        return val;
+    });
+    measure("digits and pow", [](const char * str, const char * end, const char ** outEnd) {
+        // the previous ObjReadParser::extractFloat algorithm
+        float val = 0.0f;
+        float sign = 1.0f;
+        int decimals = 0;
+        bool hasDecimal = false;
+        for (; str != end && *str != ' ' && *str != '\n'; ++str) {
+            if (*str == '-') { sign = -1.0f; }
+            else if (*str == '.') { hasDecimal = true; }
+            else {
+                val = 10.0f * val + float(*str - '0');
+                decimals += hasDecimal ? 1 : 0;
+            }
+        }
+        *outEnd = str;
+        return val / std::pow(10.0f, float(decimals)) * sign;
+    });
+    measure("strtof", [](const char * str, const char *, const char ** outEnd) {
+        char * end;
+        const float val = std::strtof(str, &end);
+        *outEnd = end;
+        return val;
+    });
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,83 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <set>
+#include "common/AttributeNames.h"
+#include "io/reader/ObjKeywords.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking the keywords lookup of the reader.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ObjKeywords, all_keywords_are_found) {
+    std::set<std::string> unique;
+    for (std::size_t i = 0; i < ObjKeywords::count(); ++i) {
+        const std::string keyword(ObjKeywords::keyword(i));
+        EXPECT_NE(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(keyword)) << keyword;
+        EXPECT_TRUE(unique.insert(keyword).second) << keyword;
+    }
+}
+
+TEST(ObjKeywords, groups) {
+    EXPECT_EQ(ObjKeywords::GROUP_TRIS, ObjKeywords::find(StringRef(MESH_TRIS)));
+    EXPECT_EQ(ObjKeywords::GROUP_ATTRIBUTE, ObjKeywords::find(StringRef(ATTR_HARD)));
+    EXPECT_EQ(ObjKeywords::GROUP_MANIPULATOR, ObjKeywords::find(StringRef(ATTR_MANIP_DRAG_AXIS)));
+    EXPECT_EQ(ObjKeywords::GROUP_GLOBAL_ATTRIBUTE, ObjKeywords::find(StringRef(ATTR_GLOBAL_TEXTURE)));
+    EXPECT_EQ(ObjKeywords::GROUP_TRANSLATE_KEYS_ANIM, ObjKeywords::find(StringRef(ATTR_TRANS_BEGIN)));
+    EXPECT_EQ(ObjKeywords::GROUP_LOD, ObjKeywords::find(StringRef(ATTR_LOD)));
+}
+
+TEST(ObjKeywords, unknown_words) {
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef()));
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef(MESH_VT)));
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef(ATTR_TRANS_KEY)));
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef("#")));
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef("ATTR_manip_non")));
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef("ATTR_manip_nonex")));
+    // the reference to the part of the text
+    const std::string line = "TRISx 0 3";
+    EXPECT_EQ(ObjKeywords::GROUP_UNKNOWN, ObjKeywords::find(StringRef(line.data(), 5)));
+    EXPECT_EQ(ObjKeywords::GROUP_TRIS, ObjKeywords::find(StringRef(line.data(), 4)));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,110 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include "io/reader/ObjReadParser.h"
+#include "../TestUtils.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking the parser reads
+ * the mapped file and the values which don't fit 32 bits.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ObjReadParser, mapped_file) {
+    const auto fileName = XOBJ_PATH("ObjReadParser-mapped_file.obj");
+    TestUtils::writeFileContent(fileName, "POINT_COUNTS 3 0 0 6\r\nVT 1.5 2 -3");
+    //-----------------------------
+    ObjReadParser parser(fileName);
+    ASSERT_TRUE(parser.isValid());
+    ASSERT_TRUE(parser.isMapped());
+    ASSERT_TRUE(parser.isMatch("POINT_COUNTS"));
+    parser.skipSpace();
+    EXPECT_EQ(3, parser.extractInt());
+    parser.skipSpace();
+    EXPECT_EQ(0, parser.extractInt());
+    parser.skipSpace();
+    EXPECT_EQ(0, parser.extractInt());
+    parser.skipSpace();
+    EXPECT_EQ(6, parser.extractInt());
+    parser.nextLine();
+    ASSERT_TRUE(parser.isMatch("VT"));
+    parser.skipSpace();
+    EXPECT_EQ(1.5f, parser.extractFloat());
+    parser.skipSpace();
+    EXPECT_EQ(2.0f, parser.extractFloat());
+    parser.skipSpace();
+    EXPECT_EQ(-3.0f, parser.extractFloat());
+    parser.skipSpace();
+    EXPECT_TRUE(parser.isEnd());
+    //-----------------------------
+    parser.close();
+    EXPECT_FALSE(parser.isValid());
+    EXPECT_FALSE(parser.isMapped());
+}
+
+TEST(ObjReadParser, int64_values) {
+    const auto fileName = XOBJ_PATH("ObjReadParser-int64_values.obj");
+    TestUtils::writeFileContent(fileName, "IDX 5000000000 -5000000000\n");
+    //-----------------------------
+    ObjReadParser parser(fileName);
+    ASSERT_TRUE(parser.isValid());
+    ASSERT_TRUE(parser.isMatch("IDX"));
+    parser.skipSpace();
+    EXPECT_EQ(INT64_C(5000000000), parser.extractInt64());
+    parser.skipSpace();
+    EXPECT_EQ(INT64_C(-5000000000), parser.extractInt64());
+}
+
+TEST(ObjReadParser, empty_and_missing_file) {
+    const auto fileName = XOBJ_PATH("ObjReadParser-empty_file.obj");
+    TestUtils::writeFileContent(fileName, "");
+    //-----------------------------
+    ObjReadParser parser(fileName);
+    ASSERT_TRUE(parser.isValid());
+    EXPECT_TRUE(parser.isEnd());
+    //-----------------------------
+    const auto missingName = XOBJ_PATH("ObjReadParser-missing_file.obj");
+    EXPECT_FALSE(parser.readFile(missingName));
+    EXPECT_FALSE(parser.isValid());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,122 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking that the output buffer of the writer
+ * doesn't change the file content. The benchmark is disabled by default,
+ * use --gtest_also_run_disabled_tests to run it.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(OutputBuffer, buffer_size_does_not_change_content) {
+    const auto fileName = XOBJ_PATH("OutputBuffer-buffer_size.obj");
+    std::string expected;
+    //-----------------------------
+    {
+        ObjMain main;
+        TestUtilsObjMesh::createTwoLodsScene(main, 50);
+        ExportContext context(fileName);
+        context.setOutputBufferSize(0);
+        ASSERT_TRUE(main.exportObj(context));
+        expected = TestUtils::readFileContent(fileName);
+        ASSERT_FALSE(expected.empty());
+    }
+    //-----------------------------
+    for (const std::size_t size : {std::size_t(1), std::size_t(7), std::size_t(4096), std::size_t(1024 * 1024)}) {
+        ObjMain main;
+        TestUtilsObjMesh::createTwoLodsScene(main, 50);
+        ExportContext context(fileName);
+        context.setOutputBufferSize(size);
+        ASSERT_TRUE(main.exportObj(context));
+        ASSERT_EQ(expected, TestUtils::readFileContent(fileName)) << " buffer size is " << size;
+    }
+    //-----------------------------
+    {
+        ObjMain main;
+        TestUtilsObjMesh::createTwoLodsScene(main, 50);
+        ExportContext context(fileName);
+        context.setOutputBufferSize(16);
+        context.setPreSizedOutputBuffer(true);
+        ASSERT_TRUE(main.exportObj(context));
+        ASSERT_EQ(expected, TestUtils::readFileContent(fileName));
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(OutputBuffer, DISABLED_benchmark) {
+    const auto fileName = XOBJ_PATH("OutputBuffer-benchmark.obj");
+    // ~2M vertices
+    const std::size_t side = 1415;
+
+    const auto measure = [&](const char * name, const std::size_t bufferSize, const bool preSized, const std::size_t threads) {
+        ObjMain main;
+        TestUtilsObjMesh::createTwoLodsScene(main, side);
+        ExportContext context(fileName);
+        context.setOutputBufferSize(bufferSize);
+        context.setPreSizedOutputBuffer(preSized);
+        context.setWorkerThreads(threads);
+
+        const auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(main.exportObj(context));
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+        const double bytes = double(TestUtils::readFileContent(fileName).size());
+        std::cout << name << ": " << bytes / (1024.0 * 1024.0) << " MiB in " << seconds.count() << " s, "
+                << (bytes / (1024.0 * 1024.0)) / seconds.count() << " MiB/s" << std::endl;
+    };
+
+    measure("line by line", 0, false, 1);
+    measure("buffered 1 MiB", 1024 * 1024, false, 1);
+    measure("pre-sized", 1024 * 1024, true, 1);
+    measure("buffered 1 MiB, parallel", 1024 * 1024, false, 0);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,106 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLine.h"
+#include "xpln/obj/ObjLightPoint.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking that the parallel vertices formatting
+ * gives the same file as the serial one.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static void fillMain(ObjMain & main) {
+    TestUtils::setTestExportOptions(main);
+    main.pExportOptions.enable(XOBJ_EXP_MARK_LIGHT);
+    // big enough to be split into chunks
+    TestUtilsObjMesh::createTwoLodsScene(main, 300);
+    ObjLodGroup & lod1 = *main.lods().at(0);
+    ObjLodGroup & lod2 = *main.lods().at(1);
+
+    auto * line = new ObjLine();
+    line->setObjectName("l1-line");
+    for (std::size_t i = 0; i < 100; ++i) {
+        line->verticesList().emplace_back(LineVertex(Point3(float(i), 0.0f, 0.0f), Color(1.0f, 0.5f, 0.25f)));
+    }
+    lod1.transform().addObject(line);
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        auto * light = new ObjLightPoint();
+        light->setObjectName("light");
+        light->setPosition(Point3(float(i), 1.0f, 2.0f));
+        light->setColor(Color(1.0f, 1.0f, 0.0f));
+        lod2.transform().addObject(light);
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ParallelExport, same_content_as_serial) {
+    const auto fileName = XOBJ_PATH("ParallelExport-same_content.obj");
+    std::string expected;
+    //-----------------------------
+    {
+        ObjMain main;
+        fillMain(main);
+        ExportContext context(fileName);
+        ASSERT_TRUE(main.exportObj(context));
+        expected = TestUtils::readFileContent(fileName);
+        ASSERT_FALSE(expected.empty());
+    }
+    //-----------------------------
+    for (const std::size_t threads : {std::size_t(0), std::size_t(2), std::size_t(7)}) {
+        ObjMain main;
+        fillMain(main);
+        ExportContext context(fileName);
+        context.setWorkerThreads(threads);
+        ASSERT_TRUE(main.exportObj(context));
+        ASSERT_EQ(expected, TestUtils::readFileContent(fileName)) << " threads count is " << threads;
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,130 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * This tests are for checking that the parallel geometry parsing
+ * gives the same objects as the serial one.
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+static std::string importAndExport(const Path & fileName, const Path & outFileName, const std::size_t threads) {
+    ObjMain main;
+    ImportContext importContext(fileName);
+    importContext.setWorkerThreads(threads);
+    if (!main.importObj(importContext)) {
+        return std::string();
+    }
+    TestUtils::setTestExportOptions(main);
+    ExportContext exportContext(outFileName);
+    if (!main.exportObj(exportContext)) {
+        return std::string();
+    }
+    return TestUtils::readFileContent(outFileName);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(ParallelImport, same_objects_as_serial) {
+    const auto fileName = XOBJ_PATH("ParallelImport-same_objects.obj");
+    const auto outFileName = XOBJ_PATH("ParallelImport-same_objects-out.obj");
+    {
+        ObjMain main;
+        TestUtils::setTestExportOptions(main);
+        // big enough to be split into chunks
+        TestUtilsObjMesh::createTwoLodsScene(main, 300);
+        ExportContext context(fileName);
+        ASSERT_TRUE(main.exportObj(context));
+    }
+    //-----------------------------
+    const std::string expected = importAndExport(fileName, outFileName, 1);
+    ASSERT_FALSE(expected.empty());
+    for (const std::size_t threads : {std::size_t(0), std::size_t(2), std::size_t(7)}) {
+        ASSERT_EQ(expected, importAndExport(fileName, outFileName, threads)) << " threads count is " << threads;
+    }
+}
+
+TEST(ParallelImport, incorrect_counts) {
+    const auto fileName = XOBJ_PATH("ParallelImport-incorrect_counts.obj");
+    const auto outFileName = XOBJ_PATH("ParallelImport-incorrect_counts-out.obj");
+    std::string content;
+    {
+        ObjMain main;
+        TestUtils::setTestExportOptions(main);
+        // big enough to be split into chunks
+        TestUtilsObjMesh::createTwoLodsScene(main, 300);
+        ExportContext context(fileName);
+        ASSERT_TRUE(main.exportObj(context));
+        content = TestUtils::readFileContent(fileName);
+    }
+    const auto countsBegin = content.find("POINT_COUNTS");
+    ASSERT_NE(std::string::npos, countsBegin);
+    const auto countsEnd = content.find('\n', countsBegin);
+    const std::string counts = content.substr(countsBegin, countsEnd - countsBegin);
+    //-----------------------------
+    std::size_t vertices = 0, lines = 0, lights = 0, indices = 0;
+    std::istringstream(counts.substr(12)) >> vertices >> lines >> lights >> indices;
+    ASSERT_NE(0u, vertices);
+    ASSERT_NE(0u, indices);
+    for (const auto & wrong : {
+             std::to_string(vertices + 1) + " 0 0 " + std::to_string(indices),
+             std::to_string(vertices - 1) + " 0 0 " + std::to_string(indices),
+             std::to_string(vertices) + " 0 0 " + std::to_string(indices + 1),
+             std::to_string(vertices) + " 0 0 " + std::to_string(indices - 1),
+         }) {
+        std::string wrongContent = content;
+        wrongContent.replace(countsBegin, countsEnd - countsBegin, "POINT_COUNTS " + wrong);
+        TestUtils::writeFileContent(fileName, wrongContent);
+        for (const std::size_t threads : {std::size_t(1), std::size_t(4)}) {
+            EXPECT_TRUE(importAndExport(fileName, outFileName, threads).empty()) << wrong << " threads count is " << threads;
+        }
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -31,6 +31,7 @@
 #include <xpln/utils/CommandsFile.h>
 #include <sstream>
 #include <vector>
+#include "../TestUtils.h"
 
 using namespace xobj;
 using namespace std::string_literals;
@@ -165,6 +166,70 @@ TEST(CommandsFile, duplicate) {
     ASSERT_TRUE(iter != commands.end());
 }
 
+TEST(CommandsFile, duplicateByKey) {
+    Commands commands = {
+        Command{1, "sim/operation/quit", "Quit X-Plane."},
+        Command{2, "sim/operation/screenshot", "Take a screenshot."},
+        Command{1, "sim/operation/show_menu", "Show the in - sim menu."},
+    };
+    //-----------------------
+    const auto iter = CommandsFile::duplicateByKey(commands, [](const Command & c) { return c.mId; });
+    ASSERT_TRUE(iter == commands.begin() + 2);
+    const auto iterKey = CommandsFile::duplicateByKey(commands, [](const Command & c) { return c.mKey; });
+    ASSERT_TRUE(iterKey == commands.end());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(CommandsFile, parse) {
+    const std::string content = "  000001: x/y/z       00: :d0.0\n"
+            "\n"
+            "000003:   1/a/b/2     22: :d2.0\r\n"
+            " 000005   :1/a/b/3    33: :d3.0\n"
+            "1/a/b/4               44: :d4.0";
+    //-----------------------
+    Commands commands;
+    ASSERT_TRUE(CommandsFile::parse(content.data(), content.size(), [&](const CommandRef & c) ->bool {
+            Command cmd;
+            c.toCommand(cmd);
+            commands.emplace_back(cmd);
+            return true;
+        }));
+    ASSERT_EQ(4, commands.size());
+    ASSERT_NO_FATAL_FAILURE(equals(Command{ 1, "x/y/z", "00: :d0.0" }, commands[0]));
+    ASSERT_NO_FATAL_FAILURE(equals(Command{ 3, "1/a/b/2", "22: :d2.0" }, commands[1]));
+    ASSERT_NO_FATAL_FAILURE(equals(Command{ Command::invalidId(), "000005", ":1/a/b/3    33: :d3.0" }, commands[2]));
+    ASSERT_NO_FATAL_FAILURE(equals(Command{ Command::invalidId(), "1/a/b/4", "44: :d4.0" }, commands[3]));
+}
+
+TEST(CommandsFile, mapFile) {
+    const auto fileName = XOBJ_PATH("CommandsFile-mapFile.txt");
+    TestUtils::writeFileContent(fileName, "000001:    sim/operation/quit    Quit X-Plane.\n");
+    Commands commands;
+    ASSERT_TRUE(CommandsFile::mapFile(fileName, [&](const CommandRef & c) ->bool {
+            Command cmd;
+            c.toCommand(cmd);
+            commands.emplace_back(cmd);
+            return true;
+        }));
+    ASSERT_EQ(1, commands.size());
+    ASSERT_NO_FATAL_FAILURE(equals(Command{ 1, "sim/operation/quit", "Quit X-Plane." }, commands[0]));
+
+    // loadFile gives the same values through mapFile.
+    Commands loaded;
+    ASSERT_TRUE(CommandsFile::loadFile(fileName, [&](const Command & c) ->bool {
+            loaded.emplace_back(c);
+            return true;
+        }));
+    ASSERT_EQ(1, loaded.size());
+    ASSERT_NO_FATAL_FAILURE(equals(commands[0], loaded[0]));
+
+    const auto missingFile = XOBJ_PATH("CommandsFile-missing.txt");
+    ASSERT_ANY_THROW(CommandsFile::mapFile(missingFile, [&](const CommandRef &) ->bool { return true; }));
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
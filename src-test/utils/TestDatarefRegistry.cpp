@@ -0,0 +1,231 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <gtest/gtest.h>
+#include <xpln/utils/DatarefRegistry.h>
+#include <xpln/utils/CommandRegistry.h>
+#include <xpln/obj/ObjMain.h>
+#include <xpln/obj/ObjMesh.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../TestUtils.h"
+#include "../TestUtilsObjMesh.h"
+
+using namespace xobj;
+using namespace std::string_literals;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(DatarefRegistry, loadStream) {
+    std::stringstream stream;
+    stream << " first line " << std::endl;
+    stream << R"(000001:a/b/1	float	y	Feet	d1)" << std::endl;
+    stream << R"(000003:a/b/3	float	y	Feet	d3)" << std::endl;
+    stream << R"(000003:a/b/3-duplicate	float	y	Feet	d3)" << std::endl;
+    stream << R"(a/b/4	float	n	Feet	d4)";
+    //-----------------------
+    DatarefRegistry::Ptr registry;
+    ASSERT_NO_THROW(registry = DatarefRegistry::loadStream(stream));
+    ASSERT_TRUE(registry);
+    ASSERT_EQ(2, registry->size());
+    ASSERT_TRUE(registry->find(1));
+    ASSERT_STREQ("a/b/1", registry->find(1)->mKey.c_str());
+    ASSERT_TRUE(registry->find(3));
+    ASSERT_STREQ("a/b/3", registry->find(3)->mKey.c_str());
+    ASSERT_FALSE(registry->find(4));
+}
+
+TEST(CommandRegistry, loadStream) {
+    std::stringstream stream;
+    stream << R"(000001:a/b/1	d1)" << std::endl;
+    stream << R"(a/b/2	d2)";
+    //-----------------------
+    CommandRegistry::Ptr registry;
+    ASSERT_NO_THROW(registry = CommandRegistry::loadStream(stream));
+    ASSERT_TRUE(registry);
+    ASSERT_EQ(1, registry->size());
+    ASSERT_TRUE(registry->find(1));
+    ASSERT_STREQ("a/b/1", registry->find(1)->mKey.c_str());
+}
+
+TEST(DatarefRegistry, loadFile_missing) {
+    const auto fileName = XOBJ_PATH("DatarefRegistry-missing.txt");
+    ASSERT_ANY_THROW(DatarefRegistry::loadFile(fileName));
+    ASSERT_ANY_THROW(DatarefRegistry::cached(fileName));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(DatarefRegistry, cached) {
+    const auto fileName = XOBJ_PATH("DatarefRegistry-cached.txt");
+    DatarefRegistry::clearCache();
+    TestUtils::writeFileContent(fileName, "header\n000001:a/b/1\n");
+
+    const auto registry1 = DatarefRegistry::cached(fileName);
+    const auto registry2 = DatarefRegistry::cached(fileName);
+    ASSERT_TRUE(registry1);
+    ASSERT_EQ(registry1.get(), registry2.get());
+    ASSERT_EQ(1, registry1->size());
+
+    // the size is changed so the file is reloaded
+    TestUtils::writeFileContent(fileName, "header\n000001:a/b/1\n000002:a/b/2\n");
+    ASSERT_EQ(registry1.get(), DatarefRegistry::cached(fileName, false).get());
+    const auto registry3 = DatarefRegistry::cached(fileName);
+    ASSERT_NE(registry1.get(), registry3.get());
+    ASSERT_EQ(2, registry3->size());
+    // the old registry stays valid
+    ASSERT_EQ(1, registry1->size());
+
+    DatarefRegistry::clearCache();
+    ASSERT_NE(registry3.get(), DatarefRegistry::cached(fileName).get());
+    DatarefRegistry::clearCache();
+}
+
+TEST(DatarefRegistry, cached_failed_loading) {
+    const auto fileName = XOBJ_PATH("DatarefRegistry-cached_failed.txt");
+    DatarefRegistry::clearCache();
+    TestUtils::removeFile(fileName);
+    ASSERT_ANY_THROW(DatarefRegistry::cached(fileName, false));
+
+    // the failed loading isn't cached
+    TestUtils::writeFileContent(fileName, "header\n000001:a/b/1\n");
+    const auto registry = DatarefRegistry::cached(fileName, false);
+    ASSERT_TRUE(registry);
+    ASSERT_EQ(1, registry->size());
+    DatarefRegistry::clearCache();
+}
+
+TEST(DatarefRegistry, cached_concurrent) {
+    const auto fileName = XOBJ_PATH("DatarefRegistry-cached_concurrent.txt");
+    DatarefRegistry::clearCache();
+    std::string content("header\n");
+    for (int i = 1; i <= 10000; ++i) {
+        content.append(std::to_string(i)).append(":a/b/").append(std::to_string(i)).append("\n");
+    }
+    TestUtils::writeFileContent(fileName, content);
+
+    std::vector<DatarefRegistry::Ptr> registries(4);
+    std::vector<std::thread> threads;
+    for (auto & registry : registries) {
+        threads.emplace_back([&registry, &fileName]() { registry = DatarefRegistry::cached(fileName); });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    // the file is parsed once
+    for (const auto & registry : registries) {
+        ASSERT_TRUE(registry);
+        ASSERT_EQ(registries[0].get(), registry.get());
+    }
+    ASSERT_EQ(10000, registries[0]->size());
+    DatarefRegistry::clearCache();
+}
+
+TEST(CommandRegistry, cached_eviction) {
+    CommandRegistry::clearCache();
+    std::vector<Path> files;
+    for (std::size_t i = 0; i < 17; ++i) {
+        Path fileName = XOBJ_PATH("CommandRegistry-cached-a.txt");
+        fileName[fileName.size() - 5] = Path::value_type('a' + i);
+        TestUtils::writeFileContent(fileName, "000001:a/b/1\n");
+        files.emplace_back(fileName);
+    }
+    const auto first = CommandRegistry::cached(files[0]);
+    const auto second = CommandRegistry::cached(files[1]);
+    ASSERT_EQ(first.get(), CommandRegistry::cached(files[0]).get());
+    for (std::size_t i = 2; i < files.size(); ++i) {
+        CommandRegistry::cached(files[i]);
+    }
+    // the second file is the least recently used one.
+    ASSERT_EQ(first.get(), CommandRegistry::cached(files[0]).get());
+    ASSERT_NE(second.get(), CommandRegistry::cached(files[1]).get());
+    // the evicted registry stays valid
+    ASSERT_EQ(1, second->size());
+    CommandRegistry::clearCache();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(DatarefRegistry, export_context) {
+    std::stringstream stream;
+    stream << " first line " << std::endl;
+    stream << R"(000042:sim/test/value	float	y	Feet	description)";
+    const auto registry = DatarefRegistry::loadStream(stream);
+
+    std::string result;
+    ObjMain main;
+    TestUtilsObjMesh::createAnimatedScene(main, "42");
+    ExportContext context;
+    context.setDatarefRegistry(registry);
+    context.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_NE(std::string::npos, result.find("sim/test/value"));
+    ASSERT_EQ(std::string::npos, result.find(" 42"));
+}
+
+TEST(DatarefRegistry, export_file) {
+    const auto fileName = XOBJ_PATH("DatarefRegistry-export.txt");
+    TestUtils::writeFileContent(fileName, "header\n000042:sim/test/value\tfloat\ty\tFeet\tdescription\n");
+
+    std::string result;
+    ObjMain main;
+    TestUtilsObjMesh::createAnimatedScene(main, "42");
+    ExportContext context;
+    context.setDatarefsFile(fileName);
+    context.setOutputString(result);
+    ASSERT_TRUE(main.exportObj(context));
+    ASSERT_NE(std::string::npos, result.find("sim/test/value"));
+}
+
+TEST(DatarefRegistry, export_missing) {
+    std::stringstream stream;
+    stream << " first line " << std::endl;
+    stream << R"(000041:sim/test/value)";
+
+    std::string result;
+    ObjMain main;
+    TestUtilsObjMesh::createAnimatedScene(main, "42");
+    ExportContext context;
+    context.setDatarefRegistry(DatarefRegistry::loadStream(stream));
+    context.setOutputString(result);
+    ASSERT_FALSE(main.exportObj(context));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
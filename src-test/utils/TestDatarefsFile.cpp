@@ -31,6 +31,7 @@
 #include <xpln/utils/DatarefsFile.h>
 #include <sstream>
 #include <vector>
+#include "../TestUtils.h"
 
 using namespace xobj;
 using namespace std::string_literals;
@@ -205,6 +206,122 @@ TEST(DatarefsFile, duplicate) {
     ASSERT_TRUE(iter != datarefs.end());
 }
 
+TEST(DatarefsFile, duplicate_not_found) {
+    const Datarefs datarefs = {
+        Dataref{false, 1, "only_key_test_2", "", "", ""},
+        Dataref{false, 2, "only_key_test_3", "", "", ""},
+    };
+    //-----------------------
+    const auto iter = DatarefsFile::duplicate(datarefs, [&](const Dataref & d1, const Dataref & d2) ->bool {
+        return d1.mId == d2.mId;
+    });
+    ASSERT_TRUE(iter == datarefs.end());
+}
+
+TEST(DatarefsFile, duplicateByKey) {
+    const Datarefs datarefs = {
+        Dataref{false, 1, "only_key_test_1", "", "", ""},
+        Dataref{false, 2, "only_key_test_2", "", "", ""},
+        Dataref{false, 1, "only_key_test_3", "", "", ""},
+    };
+    //-----------------------
+    const auto iter = DatarefsFile::duplicateByKey(datarefs, [](const Dataref & d) { return d.mId; });
+    ASSERT_TRUE(iter == datarefs.begin() + 2);
+    const auto iterKey = DatarefsFile::duplicateByKey(datarefs, [](const Dataref & d) { return d.mKey; });
+    ASSERT_TRUE(iterKey == datarefs.end());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(DatarefsFile, parse) {
+    const std::string content = " first line \n"
+            "\n"
+            "   \n"
+            " x/y/z \n"
+            "  000001:1/a/b/1\tfloat int\t\ty t\t\tFeet Meters\t\t:d1.0 11: d1.1\n"
+            "000003:   1/a/b/2\tfloat\tn\tFeet\t:d2.0\n"
+            " 000005   :1/a/b/3\tfloat\ty\n"
+            "1/a/b/4";
+    //-----------------------
+    Datarefs expected;
+    std::stringstream stream(content);
+    ASSERT_TRUE(DatarefsFile::loadStream(stream, [&](const Dataref & d) ->bool {
+            expected.emplace_back(d);
+            return true;
+        }));
+    ASSERT_EQ(5, expected.size());
+    //-----------------------
+    Datarefs datarefs;
+    ASSERT_TRUE(DatarefsFile::parse(content.data(), content.size(), [&](const DatarefRef & d) ->bool {
+            Dataref drf;
+            d.toDataref(drf);
+            datarefs.emplace_back(drf);
+            return true;
+        }));
+    ASSERT_EQ(expected.size(), datarefs.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NO_FATAL_FAILURE(equals(expected[i], datarefs[i]));
+    }
+    ASSERT_NO_FATAL_FAILURE(equals(Dataref{ true, 1, "1/a/b/1", "float int", "Feet Meters", ":d1.0 11: d1.1"}, datarefs[1]));
+    ASSERT_NO_FATAL_FAILURE(equals(Dataref{ true, Dataref::invalidId(), "000005", "float", "", ""}, datarefs[3]));
+}
+
+TEST(DatarefsFile, parse_crlf) {
+    const std::string content = "first line\r\n000001:1/a/b/1\tfloat\ty\tFeet\tdescription\r\n1/a/b/2\r\n";
+    Datarefs datarefs;
+    ASSERT_TRUE(DatarefsFile::parse(content.data(), content.size(), [&](const DatarefRef & d) ->bool {
+            Dataref drf;
+            d.toDataref(drf);
+            datarefs.emplace_back(drf);
+            return true;
+        }));
+    ASSERT_EQ(2, datarefs.size());
+    ASSERT_NO_FATAL_FAILURE(equals(Dataref{ true, 1, "1/a/b/1", "float", "Feet", "description"}, datarefs[0]));
+    ASSERT_NO_FATAL_FAILURE(equals(Dataref{ false, Dataref::invalidId(), "1/a/b/2", "", "", ""}, datarefs[1]));
+}
+
+TEST(DatarefsFile, parse_stop_and_errors) {
+    const std::string content = "first line\n1/a/b/1\n1/a/b/2\n";
+    std::size_t counter = 0;
+    ASSERT_FALSE(DatarefsFile::parse(content.data(), content.size(), [&](const DatarefRef &) ->bool {
+            ++counter;
+            return false;
+        }));
+    ASSERT_EQ(1, counter);
+    ASSERT_FALSE(DatarefsFile::parse(nullptr, 0, [&](const DatarefRef &) ->bool { return true; }));
+
+    const std::string tooBigId = "first line\n31243656867453255687685634224580987856643535435:1/a/b/1\n";
+    ASSERT_ANY_THROW(DatarefsFile::parse(tooBigId.data(), tooBigId.size(), [&](const DatarefRef &) ->bool { return true; }));
+}
+
+TEST(DatarefsFile, mapFile) {
+    const auto fileName = XOBJ_PATH("DatarefsFile-mapFile.txt");
+    TestUtils::writeFileContent(fileName, "first line\n000001:1/a/b/1\tfloat\ty\tFeet\tdescription\n");
+    Datarefs datarefs;
+    ASSERT_TRUE(DatarefsFile::mapFile(fileName, [&](const DatarefRef & d) ->bool {
+            Dataref drf;
+            d.toDataref(drf);
+            datarefs.emplace_back(drf);
+            return true;
+        }));
+    ASSERT_EQ(1, datarefs.size());
+    ASSERT_NO_FATAL_FAILURE(equals(Dataref{ true, 1, "1/a/b/1", "float", "Feet", "description"}, datarefs[0]));
+
+    // loadFile gives the same values through mapFile.
+    Datarefs loaded;
+    ASSERT_TRUE(DatarefsFile::loadFile(fileName, [&](const Dataref & d) ->bool {
+            loaded.emplace_back(d);
+            return true;
+        }));
+    ASSERT_EQ(1, loaded.size());
+    ASSERT_NO_FATAL_FAILURE(equals(datarefs[0], loaded[0]));
+
+    const auto missingFile = XOBJ_PATH("DatarefsFile-missing.txt");
+    ASSERT_ANY_THROW(DatarefsFile::mapFile(missingFile, [&](const DatarefRef &) ->bool { return true; }));
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
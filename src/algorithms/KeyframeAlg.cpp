@@ -0,0 +1,149 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cmath>
+#include <vector>
+#include "KeyframeAlg.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Static area *///////////////////////////////////////////
+/**************************************************************************************************/
+
+template<typename Key>
+bool isStrictlyMonotonic(const std::vector<Key> & keys) {
+    bool ascending = true;
+    bool descending = true;
+    for (std::size_t i = 1; i < keys.size(); ++i) {
+        ascending = ascending && keys[i - 1].pDrfValue < keys[i].pDrfValue;
+        descending = descending && keys[i - 1].pDrfValue > keys[i].pDrfValue;
+    }
+    return ascending || descending;
+}
+
+/*!
+ * \details Checks whether the keys between the first and the last ones
+ *          can be interpolated from those two keys.
+ */
+template<typename Key, typename Error>
+bool isSegmentLinear(const std::vector<Key> & keys, const std::size_t first, const std::size_t last,
+                     const float tolerance, const Error & error) {
+    const float range = keys[last].pDrfValue - keys[first].pDrfValue;
+    for (std::size_t i = first + 1; i < last; ++i) {
+        const float t = (keys[i].pDrfValue - keys[first].pDrfValue) / range;
+        if (error(keys[i], keys[first], keys[last], t) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \details Each segment starts from the last kept key and it is extended
+ *          while all the keys inside it are within the tolerance.
+ */
+template<typename Key, typename Error>
+std::size_t reduceKeys(std::vector<Key> & inOutKeys, const float tolerance, const Error & error) {
+    if (inOutKeys.size() < 3 || !isStrictlyMonotonic(inOutKeys)) {
+        return 0;
+    }
+    std::vector<Key> result;
+    result.reserve(inOutKeys.size());
+    result.emplace_back(inOutKeys.front());
+
+    std::size_t first = 0;
+    while (first + 1 < inOutKeys.size()) {
+        std::size_t last = first + 1;
+        while (last + 1 < inOutKeys.size() && isSegmentLinear(inOutKeys, first, last + 1, tolerance, error)) {
+            ++last;
+        }
+        result.emplace_back(inOutKeys[last]);
+        first = last;
+    }
+
+    const std::size_t removed = inOutKeys.size() - result.size();
+    inOutKeys.swap(result);
+    return removed;
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+bool KeyframeAlg::isZero(const AnimTrans & anim, const float tolerance) {
+    for (const auto & key : anim.pKeys) {
+        if (key.pPosition.length() > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool KeyframeAlg::isZero(const AnimRotate & anim, const float toleranceDegrees) {
+    for (const auto & key : anim.pKeys) {
+        if (std::abs(key.pAngleDegrees) > toleranceDegrees) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t KeyframeAlg::reduce(AnimTrans & inOutAnim, const float tolerance) {
+    if (isZero(inOutAnim, tolerance)) {
+        const std::size_t removed = inOutAnim.pKeys.size();
+        inOutAnim.pKeys.clear();
+        return removed;
+    }
+
+    return reduceKeys(inOutAnim.pKeys, tolerance, [](const AnimTrans::Key & key, const AnimTrans::Key & first,
+                                                     const AnimTrans::Key & last, const float t) {
+        const Point3 interpolated = first.pPosition + (last.pPosition - first.pPosition) * t;
+        return (interpolated - key.pPosition).length();
+    });
+}
+
+std::size_t KeyframeAlg::reduce(AnimRotate & inOutAnim, const float toleranceDegrees) {
+    if (isZero(inOutAnim, toleranceDegrees)) {
+        const std::size_t removed = inOutAnim.pKeys.size();
+        inOutAnim.pKeys.clear();
+        return removed;
+    }
+
+    return reduceKeys(inOutAnim.pKeys, toleranceDegrees, [](const AnimRotate::Key & key, const AnimRotate::Key & first,
+                                                            const AnimRotate::Key & last, const float t) {
+        const float interpolated = first.pAngleDegrees + (last.pAngleDegrees - first.pAngleDegrees) * t;
+        return std::abs(interpolated - key.pAngleDegrees);
+    });
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
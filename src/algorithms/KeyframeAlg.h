@@ -0,0 +1,99 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include "xpln/Export.h"
+#include "xpln/obj/animation/AnimTrans.h"
+#include "xpln/obj/animation/AnimRotate.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Simplification of the animation keys.
+ *          The keys are linearly interpolated by the dataref value,
+ *          so a key which lies on the line between its neighbours within the tolerance is redundant.
+ */
+class KeyframeAlg {
+    KeyframeAlg() = default;
+    ~KeyframeAlg() = default;
+public:
+
+    //-------------------------------------------------------------------------
+    /// @{
+
+    /*!
+     * \details Removes the keys which can be interpolated from the remaining ones
+     *          with the error not greater than the tolerance. The first and the last keys are kept,
+     *          so the list of the equivalent of two keys is printed in the compact form (ANIM_trans).
+     *          If all the keys are zero within the tolerance the animation doesn't do anything
+     *          and all its keys are removed.
+     * \note The keys are not changed if their dataref values aren't strictly monotonic.
+     * \param [in, out] inOutAnim
+     * \param [in] tolerance max distance in the position units.
+     * \return Count of the removed keys.
+     */
+    XpObjLib static std::size_t reduce(AnimTrans & inOutAnim, float tolerance);
+
+    /*!
+     * \copydoc KeyframeAlg::reduce(AnimTrans &, float)
+     * \param [in, out] inOutAnim
+     * \param [in] toleranceDegrees max angle difference in degrees.
+     */
+    XpObjLib static std::size_t reduce(AnimRotate & inOutAnim, float toleranceDegrees);
+
+    /*!
+     * \details Checks whether all the keys are zero within the tolerance,
+     *          such an animation is removed by \link KeyframeAlg::reduce \endlink.
+     * \param [in] anim
+     * \param [in] tolerance max distance in the position units.
+     */
+    XpObjLib static bool isZero(const AnimTrans & anim, float tolerance);
+
+    /*!
+     * \copydoc KeyframeAlg::isZero(const AnimTrans &, float)
+     * \param [in] anim
+     * \param [in] toleranceDegrees max angle difference in degrees.
+     */
+    XpObjLib static bool isZero(const AnimRotate & anim, float toleranceDegrees);
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
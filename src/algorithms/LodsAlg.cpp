@@ -28,16 +28,129 @@
 */
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
 #include "LodsAlg.h"
 #include "common/Logger.h"
 #include "sts/utilities/Compare.h"
 #include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLine.h"
 #include "common/IInterrupterInternal.h"
+#include "MeshDecimationAlg.h"
 
 using namespace std::string_literals;
 
 namespace xobj {
 
+/**************************************************************************************************/
+//////////////////////////////////////////* Static area *///////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Structural FNV-1a hash of the transform tree.
+ *          Only the exact integer data is hashed: the objects types, the vertices and keys counts
+ *          and the faces indices, so the trees which are equal by isSameTree always have the same hash
+ *          even though the float values are compared with the epsilon.
+ */
+class TreeHash {
+public:
+
+    explicit TreeHash(const Transform & transform) {
+        add(transform);
+    }
+
+    std::uint64_t value() const { return mHash; }
+
+private:
+
+    void mix(const std::uint64_t val) {
+        mHash ^= val;
+        mHash *= 1099511628211ULL;
+    }
+
+    void add(const Transform & transform) {
+        mix(transform.pAnimTrans.size());
+        for (const auto & anim : transform.pAnimTrans) {
+            mix(anim.pKeys.size());
+        }
+        mix(transform.pAnimRotate.size());
+        for (const auto & anim : transform.pAnimRotate) {
+            mix(anim.pKeys.size());
+        }
+        mix(transform.pAnimVis.pKeys.size());
+
+        mix(transform.objList().size());
+        for (const auto & obj : transform.objList()) {
+            mix(std::uint64_t(obj->objType()));
+            if (obj->objType() == OBJ_MESH) {
+                const auto * mesh = static_cast<const ObjMesh*>(obj.get());
+                mix(mesh->verticesCount());
+                mix(mesh->pFaces.size());
+                for (const auto & f : mesh->pFaces) {
+                    mix(f.pV0);
+                    mix(f.pV1);
+                    mix(f.pV2);
+                }
+            }
+            else if (obj->objType() == OBJ_LINE) {
+                mix(static_cast<const ObjLine*>(obj.get())->verticesList().size());
+            }
+        }
+
+        mix(transform.childrenNum());
+        for (Transform::TransformIndex i = 0; i < transform.childrenNum(); ++i) {
+            add(*transform.childAt(i));
+        }
+    }
+
+    std::uint64_t mHash = 14695981039346656037ULL;
+
+};
+
+inline bool isSameObject(const ObjAbstract & obj1, const ObjAbstract & obj2) {
+    if (obj1.objType() != obj2.objType() ||
+        obj1.dataBefore() != obj2.dataBefore() ||
+        obj1.dataAfter() != obj2.dataAfter()) {
+        return false;
+    }
+    if (obj1.objType() == OBJ_MESH) {
+        const auto & mesh1 = static_cast<const ObjMesh&>(obj1);
+        const auto & mesh2 = static_cast<const ObjMesh&>(obj2);
+        return mesh1.pAttr == mesh2.pAttr &&
+               mesh1.pFaces == mesh2.pFaces &&
+               mesh1.verticesCount() == mesh2.verticesCount() &&
+               std::equal(mesh1.vertices(), mesh1.vertices() + mesh1.verticesCount(), mesh2.vertices());
+    }
+    if (obj1.objType() == OBJ_LINE) {
+        return static_cast<const ObjLine&>(obj1).verticesList() == static_cast<const ObjLine&>(obj2).verticesList();
+    }
+    // other objects don't have the comparison, so they are never considered identical.
+    return false;
+}
+
+inline bool isSameTree(const Transform & tr1, const Transform & tr2) {
+    if (tr1.pMatrix != tr2.pMatrix ||
+        tr1.pAnimTrans != tr2.pAnimTrans ||
+        tr1.pAnimRotate != tr2.pAnimRotate ||
+        tr1.pAnimVis.pKeys != tr2.pAnimVis.pKeys ||
+        tr1.objList().size() != tr2.objList().size() ||
+        tr1.childrenNum() != tr2.childrenNum()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < tr1.objList().size(); ++i) {
+        if (!isSameObject(*tr1.objList()[i], *tr2.objList()[i])) {
+            return false;
+        }
+    }
+    for (Transform::TransformIndex i = 0; i < tr1.childrenNum(); ++i) {
+        if (!isSameTree(*tr1.childAt(i), *tr2.childAt(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**************************************************************************************************/
 //////////////////////////////////////////* Functions */////////////////////////////////////////////
 /**************************************************************************************************/
@@ -149,8 +262,58 @@ void LodsAlg::removeWithoutObjects(ObjMain::Lods & inOutLods, const IInterrupter
 //////////////////////////////////////////* Functions */////////////////////////////////////////////
 /**************************************************************************************************/
 
-void LodsAlg::mergeIdenticalLods(ObjMain::Lods & /*inOutLods*/, const IInterrupter & interrupt) {
-    INTERRUPT_CHECK_WITH_RETURN(interrupt);
+std::size_t LodsAlg::mergeIdenticalLods(ObjMain::Lods & inOutLods, const IInterrupter & interrupt) {
+    struct Entry {
+        std::uint64_t mHash;
+        ObjLodGroup * mLod;
+        bool operator<(const Entry & other) const {
+            if (mHash != other.mHash) {
+                return mHash < other.mHash;
+            }
+            return mLod->nearVal() < other.mLod->nearVal();
+        }
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(inOutLods.size());
+    for (const auto & lod : inOutLods) {
+        INTERRUPT_CHECK_WITH_RETURN_VAL(interrupt, 0);
+        if (lod) {
+            entries.emplace_back(Entry{TreeHash(lod->transform()).value(), lod.get()});
+        }
+    }
+    // the LODs with the same hash are adjacent and ordered by their "near" values,
+    // so the chains of the adjacent distance bands are merged in one pass.
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<const ObjLodGroup*> removed;
+    for (std::size_t first = 0; first < entries.size();) {
+        ObjLodGroup * target = entries[first].mLod;
+        std::size_t next = first + 1;
+        for (; next < entries.size() && entries[next].mHash == entries[first].mHash; ++next) {
+            ObjLodGroup * lod = entries[next].mLod;
+            if (target->farVal() == lod->nearVal() && isSameTree(target->transform(), lod->transform())) {
+#ifndef NDEBUG
+                LInfo << "LOD <" << lod->objectName() << "> is merged into the identical LOD <"
+                        << target->objectName() << ">.";
+#endif
+                target->setFarVal(lod->farVal());
+                removed.emplace_back(lod);
+            }
+            else {
+                target = lod;
+            }
+        }
+        first = next;
+    }
+
+    if (!removed.empty()) {
+        std::sort(removed.begin(), removed.end());
+        inOutLods.erase(std::remove_if(inOutLods.begin(), inOutLods.end(), [&](const auto & lod) {
+            return std::binary_search(removed.begin(), removed.end(), lod.get());
+        }), inOutLods.end());
+    }
+    return removed.size();
 }
 
 /**************************************************************************************************/
@@ -204,6 +367,91 @@ bool LodsAlg::sort(ObjMain::Lods & inOutLods, const IInterrupter & interrupt) {
     return true;
 }
 
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+bool LodsAlg::generate(ObjMain::Lods & inOutLods, const std::vector<LodLevel> & levels, const IInterrupter & interrupt) {
+    INTERRUPT_CHECK_WITH_RETURN_VAL(interrupt, false);
+    const auto source = std::find_if(inOutLods.begin(), inOutLods.end(), [](const auto & lod) {
+        return lod && lod->nearVal() == 0.0f;
+    });
+    if (source == inOutLods.end()) {
+        LError << R"(The LODs can't be generated because there isn't the LOD whose "near" value equals 0.0)";
+        return false;
+    }
+    const ObjLodGroup & sourceLod = **source;
+
+    float nearVal = sourceLod.farVal();
+    for (const auto & level : levels) {
+        if (!(level.pFar > nearVal) || !(level.pFacesRatio > 0.0f) || level.pFacesRatio > 1.0f) {
+            LError << "The LODs can't be generated from <" << sourceLod.objectName() << R"(> because the level "far:)"
+                    << level.pFar << R"(" "faces ratio:)" << level.pFacesRatio << R"(" is incorrect.)"
+                    << R"( The "far" values must be ascending starting from the source LOD's one and the ratio must be in (0.0, 1.0].)";
+            return false;
+        }
+        nearVal = level.pFar;
+    }
+
+    // The existing LODs in the generated range would make the LODs sequence incorrect.
+    if (!levels.empty()) {
+        const float beginVal = sourceLod.farVal();
+        const float endVal = levels.back().pFar;
+        for (const auto & lod : inOutLods) {
+            if (lod && lod.get() != &sourceLod && lod->nearVal() < endVal && lod->farVal() > beginVal) {
+                LError << "The LODs can't be generated from <" << sourceLod.objectName() << "> because the LOD <"
+                        << lod->objectName() << "> overlaps the generated distance range "
+                        << beginVal << " - " << endVal << ".";
+                return false;
+            }
+        }
+    }
+
+    ObjMain::Lods generated;
+    nearVal = sourceLod.farVal();
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        INTERRUPT_CHECK_WITH_RETURN_VAL(interrupt, false);
+        auto lod = std::make_unique<ObjLodGroup>(sourceLod.objectName() + " " + std::to_string(i + 1),
+                                                 nearVal, levels[i].pFar);
+        copyDecimated(sourceLod.transform(), lod->transform(), levels[i].pFacesRatio);
+        lod->transform().setName(lod->objectName());
+        generated.emplace_back(std::move(lod));
+        nearVal = levels[i].pFar;
+    }
+    for (auto & lod : generated) {
+        inOutLods.emplace_back(std::move(lod));
+    }
+    return true;
+}
+
+void LodsAlg::copyDecimated(const Transform & source, Transform & target, const float facesRatio) {
+    target.setName(source.name());
+    target.pMatrix = source.pMatrix;
+    target.pAnimTrans = source.pAnimTrans;
+    target.pAnimRotate = source.pAnimRotate;
+    target.pAnimVis = source.pAnimVis;
+
+    for (const auto & obj : source.objList()) {
+        ObjAbstract * copy = obj->clone();
+        if (copy->objType() == OBJ_MESH) {
+            auto * mesh = static_cast<ObjMesh*>(copy);
+            // The collision and the manipulators need the exact geometry.
+            if (mesh->pAttr.hard()) {
+                mesh->pAttr.setHard(AttrHard());
+            }
+            else if (mesh->pAttr.manipulator() == nullptr) {
+                const auto facesCount = std::size_t(std::ceil(float(mesh->pFaces.size()) * facesRatio));
+                MeshDecimationAlg::decimate(*mesh, std::max(facesCount, std::size_t(1)));
+            }
+        }
+        target.addObject(copy);
+    }
+
+    for (Transform::TransformIndex i = 0; i < source.childrenNum(); ++i) {
+        copyDecimated(*source.childAt(i), target.newChild(), facesRatio);
+    }
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
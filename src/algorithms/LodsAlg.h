@@ -74,12 +74,18 @@ public:
     XpObjLib static void removeWithoutObjects(ObjMain::Lods & inOutLods, const IInterrupter & interrupt);
 
     /*!
-     * \todo not implemented
-     * \details It merges objects of identical LODs into one LOD.
+     * \details Merges the LODs with the identical geometry, attributes and animation
+     *          whose distance bands are adjacent (the "far" of one is the "near" of another)
+     *          into one LOD with the united band.
+     * \details The candidates are found by the structural hash of the transform trees,
+     *          so only the LODs with the same hash are compared deeply.
+     * \note Only the meshes and the lines are compared, the LODs with other objects aren't merged.
+     * \note The merged LODs are destroyed.
      * \param [in, out] inOutLods
      * \param [in] interrupt
+     * \return Count of the removed LODs.
      */
-    XpObjLib static void mergeIdenticalLods(ObjMain::Lods & inOutLods, const IInterrupter & interrupt);
+    XpObjLib static std::size_t mergeIdenticalLods(ObjMain::Lods & inOutLods, const IInterrupter & interrupt);
 
     /*!
      * \details Sorts the LOD according to obj specification.
@@ -94,6 +100,28 @@ public:
 
     /// @}
     //-------------------------------------------------------------------------
+    /// @{
+
+    /*!
+     * \details Generates the LODs from the LOD whose "near" value is 0.0.
+     * \see \link ObjMain::generateLods \endlink
+     * \param [in, out] inOutLods
+     * \param [in] levels
+     * \param [in] interrupt
+     * \return False if the source LOD isn't found, the levels are incorrect,
+     *         other LODs overlap the generated distance range
+     *         or the algorithm was interrupted otherwise true.
+     */
+    XpObjLib static bool generate(ObjMain::Lods & inOutLods, const std::vector<LodLevel> & levels,
+                                  const IInterrupter & interrupt);
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+private:
+
+    static void copyDecimated(const Transform & source, Transform & target, float facesRatio);
+
 
 };
 
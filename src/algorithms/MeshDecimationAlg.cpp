@@ -0,0 +1,368 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "MeshDecimationAlg.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Static area *///////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Symmetric 4x4 matrix of the plane distances, only the upper triangle is stored.
+ */
+class Quadric {
+public:
+
+    Quadric() {
+        mData.fill(0.0);
+    }
+
+    Quadric(const double a, const double b, const double c, const double d, const double weight)
+        : mData{{a * a * weight, a * b * weight, a * c * weight, a * d * weight,
+                 b * b * weight, b * c * weight, b * d * weight,
+                 c * c * weight, c * d * weight,
+                 d * d * weight}} {}
+
+    Quadric & operator+=(const Quadric & other) {
+        for (std::size_t i = 0; i < mData.size(); ++i) {
+            mData[i] += other.mData[i];
+        }
+        return *this;
+    }
+
+    friend Quadric operator+(Quadric left, const Quadric & right) {
+        left += right;
+        return left;
+    }
+
+    double error(const Point3 & p) const {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        return mData[0] * x * x + 2.0 * mData[1] * x * y + 2.0 * mData[2] * x * z + 2.0 * mData[3] * x +
+               mData[4] * y * y + 2.0 * mData[5] * y * z + 2.0 * mData[6] * y +
+               mData[7] * z * z + 2.0 * mData[8] * z +
+               mData[9];
+    }
+
+private:
+
+    std::array<double, 10> mData;
+
+};
+
+typedef std::array<std::size_t, 3> Triangle;
+typedef std::array<double, 3> Vector;
+
+inline Vector faceNormal(const Point3 & p0, const Point3 & p1, const Point3 & p2) {
+    const double ax = p1.x - p0.x;
+    const double ay = p1.y - p0.y;
+    const double az = p1.z - p0.z;
+    const double bx = p2.x - p0.x;
+    const double by = p2.y - p0.y;
+    const double bz = p2.z - p0.z;
+    return Vector{ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx};
+}
+
+inline double dot(const Vector & a, const Vector & b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline double length(const Vector & a) {
+    return std::sqrt(dot(a, a));
+}
+
+inline bool hasVertex(const Triangle & triangle, const std::size_t vertex) {
+    return triangle[0] == vertex || triangle[1] == vertex || triangle[2] == vertex;
+}
+
+/*!
+ * \details The collapse of the vertex "from" into the vertex "to".
+ *          It is valid only while both vertices have the same versions as when it was calculated.
+ */
+struct Collapse {
+    double mCost;
+    std::size_t mFrom;
+    std::size_t mTo;
+    std::size_t mFromVersion;
+    std::size_t mToVersion;
+
+    bool operator>(const Collapse & other) const {
+        return mCost > other.mCost;
+    }
+};
+
+/*!
+ * \details Mesh connectivity for the edge collapses.
+ */
+class Decimation {
+public:
+
+    explicit Decimation(const ObjMesh & mesh)
+        : mVertices(mesh.vertices()),
+          mQuadrics(mesh.verticesCount()),
+          mVertexFaces(mesh.verticesCount()),
+          mVersions(mesh.verticesCount(), 0),
+          mLocked(mesh.verticesCount(), false),
+          mRemoved(mesh.verticesCount(), false) {
+
+        mTriangles.reserve(mesh.pFaces.size());
+        mLiveTriangles.reserve(mesh.pFaces.size());
+        for (const auto & face : mesh.pFaces) {
+            mTriangles.emplace_back(Triangle{face.pV0, face.pV1, face.pV2});
+            mLiveTriangles.emplace_back(true);
+        }
+        mLiveCount = mTriangles.size();
+
+        for (std::size_t i = 0; i < mTriangles.size(); ++i) {
+            const Triangle & t = mTriangles[i];
+            const Vector n = faceNormal(mVertices[t[0]].pPosition, mVertices[t[1]].pPosition, mVertices[t[2]].pPosition);
+            const double len = length(n);
+            if (len > 0.0) {
+                // the plane quadric weighted by the face area
+                const double a = n[0] / len;
+                const double b = n[1] / len;
+                const double c = n[2] / len;
+                const Point3 & p = mVertices[t[0]].pPosition;
+                const double d = -(a * p.x + b * p.y + c * p.z);
+                const Quadric q(a, b, c, d, len * 0.5);
+                for (const auto v : t) {
+                    mQuadrics[v] += q;
+                }
+            }
+            for (const auto v : t) {
+                mVertexFaces[v].emplace_back(i);
+            }
+        }
+
+        // The vertices of the edges which have not exactly 2 faces
+        // are on the border, UV seam or non-manifold part of the mesh.
+        std::unordered_map<std::uint64_t, std::size_t> edges;
+        edges.reserve(mTriangles.size() * 3);
+        for (const auto & t : mTriangles) {
+            for (std::size_t i = 0; i < 3; ++i) {
+                ++edges[edgeKey(t[i], t[(i + 1) % 3])];
+            }
+        }
+        for (const auto & edge : edges) {
+            if (edge.second != 2) {
+                mLocked[std::size_t(edge.first >> 32)] = true;
+                mLocked[std::size_t(edge.first & 0xFFFFFFFF)] = true;
+            }
+        }
+        for (const auto & edge : edges) {
+            pushEdge(std::size_t(edge.first >> 32), std::size_t(edge.first & 0xFFFFFFFF));
+        }
+    }
+
+    void run(const std::size_t targetFacesCount) {
+        while (mLiveCount > targetFacesCount && !mQueue.empty()) {
+            const Collapse collapse = mQueue.top();
+            mQueue.pop();
+            if (mRemoved[collapse.mFrom] || mRemoved[collapse.mTo] ||
+                mVersions[collapse.mFrom] != collapse.mFromVersion ||
+                mVersions[collapse.mTo] != collapse.mToVersion) {
+                continue;
+            }
+            if (isCollapsible(collapse.mFrom, collapse.mTo)) {
+                apply(collapse.mFrom, collapse.mTo);
+            }
+        }
+    }
+
+    void result(ObjMesh & outMesh) const {
+        std::vector<std::size_t> remap(mQuadrics.size(), std::size_t(-1));
+        ObjMesh::VertexList vertices;
+        ObjMesh::FaceList faces;
+        faces.reserve(mLiveCount);
+        for (std::size_t i = 0; i < mTriangles.size(); ++i) {
+            if (!mLiveTriangles[i]) {
+                continue;
+            }
+            std::array<std::size_t, 3> indices;
+            for (std::size_t c = 0; c < 3; ++c) {
+                std::size_t & index = remap[mTriangles[i][c]];
+                if (index == std::size_t(-1)) {
+                    index = vertices.size();
+                    vertices.emplace_back(mVertices[mTriangles[i][c]]);
+                }
+                indices[c] = index;
+            }
+            faces.emplace_back(indices[0], indices[1], indices[2]);
+        }
+        outMesh.setSharedVertices(nullptr, 0, 0);
+        outMesh.pVertices.swap(vertices);
+        outMesh.pFaces.swap(faces);
+    }
+
+    std::size_t liveCount() const { return mLiveCount; }
+
+private:
+
+    static std::uint64_t edgeKey(const std::size_t v0, const std::size_t v1) {
+        return (std::uint64_t(std::min(v0, v1)) << 32) | std::uint64_t(std::max(v0, v1));
+    }
+
+    void pushCollapse(const std::size_t from, const std::size_t to) {
+        if (mLocked[from]) {
+            return;
+        }
+        const double cost = (mQuadrics[from] + mQuadrics[to]).error(mVertices[to].pPosition);
+        mQueue.push(Collapse{cost, from, to, mVersions[from], mVersions[to]});
+    }
+
+    void pushEdge(const std::size_t v0, const std::size_t v1) {
+        pushCollapse(v0, v1);
+        pushCollapse(v1, v0);
+    }
+
+    void neighbours(const std::size_t vertex, std::vector<std::size_t> & outList) const {
+        outList.clear();
+        for (const auto f : mVertexFaces[vertex]) {
+            if (!mLiveTriangles[f]) {
+                continue;
+            }
+            for (const auto v : mTriangles[f]) {
+                if (v != vertex) {
+                    outList.emplace_back(v);
+                }
+            }
+        }
+        std::sort(outList.begin(), outList.end());
+        outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+    }
+
+    bool isCollapsible(const std::size_t from, const std::size_t to) {
+        neighbours(from, mFromNeighbours);
+        if (!std::binary_search(mFromNeighbours.begin(), mFromNeighbours.end(), to)) {
+            return false;
+        }
+        // The link condition: the edge of the manifold mesh has only 2 opposite vertices.
+        neighbours(to, mToNeighbours);
+        mCommon.clear();
+        std::set_intersection(mFromNeighbours.begin(), mFromNeighbours.end(),
+                              mToNeighbours.begin(), mToNeighbours.end(), std::back_inserter(mCommon));
+        if (mCommon.size() != 2) {
+            return false;
+        }
+        // The remaining faces must not be flipped or degenerated.
+        for (const auto f : mVertexFaces[from]) {
+            const Triangle & t = mTriangles[f];
+            if (!mLiveTriangles[f] || hasVertex(t, to)) {
+                continue;
+            }
+            const auto position = [&](const std::size_t v) -> const Point3 & {
+                return mVertices[v == from ? to : v].pPosition;
+            };
+            const Vector before = faceNormal(mVertices[t[0]].pPosition, mVertices[t[1]].pPosition, mVertices[t[2]].pPosition);
+            const Vector after = faceNormal(position(t[0]), position(t[1]), position(t[2]));
+            const double lenBefore = length(before);
+            const double lenAfter = length(after);
+            if (lenAfter <= 0.0 || (lenBefore > 0.0 && dot(before, after) < 0.2 * lenBefore * lenAfter)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void apply(const std::size_t from, const std::size_t to) {
+        for (const auto f : mVertexFaces[from]) {
+            if (!mLiveTriangles[f]) {
+                continue;
+            }
+            Triangle & t = mTriangles[f];
+            if (hasVertex(t, to)) {
+                mLiveTriangles[f] = false;
+                --mLiveCount;
+                continue;
+            }
+            std::replace(t.begin(), t.end(), from, to);
+            mVertexFaces[to].emplace_back(f);
+        }
+        mVertexFaces[from].clear();
+        mRemoved[from] = true;
+        mQuadrics[to] += mQuadrics[from];
+        ++mVersions[to];
+
+        neighbours(to, mToNeighbours);
+        for (const auto v : mToNeighbours) {
+            pushEdge(to, v);
+        }
+    }
+
+    const MeshVertex * mVertices;
+    std::vector<Triangle> mTriangles;
+    std::vector<bool> mLiveTriangles;
+    std::vector<Quadric> mQuadrics;
+    std::vector<std::vector<std::size_t>> mVertexFaces;
+    std::vector<std::size_t> mVersions;
+    std::vector<bool> mLocked;
+    std::vector<bool> mRemoved;
+    std::size_t mLiveCount = 0;
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> mQueue;
+    std::vector<std::size_t> mFromNeighbours;
+    std::vector<std::size_t> mToNeighbours;
+    std::vector<std::size_t> mCommon;
+
+};
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+std::size_t MeshDecimationAlg::decimate(ObjMesh & inOutMesh, const std::size_t targetFacesCount) {
+    const std::size_t facesCount = inOutMesh.pFaces.size();
+    if (facesCount <= targetFacesCount) {
+        return 0;
+    }
+    Decimation decimation(inOutMesh);
+    decimation.run(targetFacesCount);
+    if (decimation.liveCount() == facesCount) {
+        return 0;
+    }
+    decimation.result(inOutMesh);
+    return facesCount - inOutMesh.pFaces.size();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include "xpln/Export.h"
+#include "xpln/obj/ObjMesh.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Mesh simplification for the generated LODs.
+ */
+class MeshDecimationAlg {
+    MeshDecimationAlg() = default;
+    ~MeshDecimationAlg() = default;
+public:
+
+    //-------------------------------------------------------------------------
+    /// @{
+
+    /*!
+     * \details Decreases the faces count by the quadric error edge collapse (Garland and Heckbert).
+     *          A vertex is collapsed into one of its neighbours so the remaining vertices keep
+     *          their positions, normals and texture coordinates.
+     *          The vertices of the open edges are never removed, it keeps the mesh borders and the UV seams
+     *          (the vertices with different texture coordinates are different vertices of the mesh).
+     *          The collapses which flip a face or make the mesh non-manifold are skipped,
+     *          so the result can have more faces than the target.
+     * \param [in, out] inOutMesh
+     * \param [in] targetFacesCount
+     * \return Count of the removed faces.
+     */
+    XpObjLib static std::size_t decimate(ObjMesh & inOutMesh, std::size_t targetFacesCount);
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
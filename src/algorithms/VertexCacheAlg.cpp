@@ -0,0 +1,237 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "VertexCacheAlg.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Static area *///////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Vertex score of Tom Forsyth's algorithm, the values are precalculated.
+ */
+class ForsythScore {
+    static constexpr std::size_t MAX_VALENCE = 32;
+public:
+
+    ForsythScore() {
+        const float scaler = 1.0f / float(VertexCacheAlg::cacheSize() - 3);
+        for (std::size_t i = 0; i < VertexCacheAlg::cacheSize(); ++i) {
+            // the last triangle vertices have the same score
+            // so the algorithm doesn't prefer any of them.
+            mCacheScore[i] = i < 3 ? 0.75f : std::pow(1.0f - float(i - 3) * scaler, 1.5f);
+        }
+        for (std::size_t i = 1; i < MAX_VALENCE; ++i) {
+            mValenceScore[i] = valenceScore(i);
+        }
+        mValenceScore[0] = 0.0f;
+    }
+
+    float score(const int cachePosition, const std::size_t remaining) const {
+        if (remaining == 0) {
+            // the vertex isn't used anymore.
+            return -1.0f;
+        }
+        float res = remaining < MAX_VALENCE ? mValenceScore[remaining] : valenceScore(remaining);
+        if (cachePosition >= 0) {
+            res += mCacheScore[cachePosition];
+        }
+        return res;
+    }
+
+private:
+
+    static float valenceScore(const std::size_t remaining) {
+        // the vertices with few remaining triangles are preferred to get rid of them.
+        return 2.0f / std::sqrt(float(remaining));
+    }
+
+    float mCacheScore[VertexCacheAlg::cacheSize()];
+    float mValenceScore[MAX_VALENCE];
+
+};
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+void VertexCacheAlg::optimize(std::size_t * inOutIndices, const std::size_t indicesCount, const std::size_t verticesCount) {
+    assert(indicesCount % 3 == 0);
+    const std::size_t trisCount = indicesCount / 3;
+    if (trisCount < 2) {
+        return;
+    }
+    static const ForsythScore scores;
+    const std::size_t npos = std::size_t(-1);
+
+    //-------------------------------------------------------------------------
+    // triangles of each vertex, the active ones are at the beginning of the vertex range.
+
+    std::vector<std::size_t> remaining(verticesCount, 0);
+    for (std::size_t i = 0; i < indicesCount; ++i) {
+        assert(inOutIndices[i] < verticesCount);
+        ++remaining[inOutIndices[i]];
+    }
+    std::vector<std::size_t> trisBegin(verticesCount + 1, 0);
+    for (std::size_t v = 0; v < verticesCount; ++v) {
+        trisBegin[v + 1] = trisBegin[v] + remaining[v];
+    }
+    std::vector<std::size_t> vertexTris(indicesCount);
+    {
+        std::vector<std::size_t> fill(trisBegin.begin(), trisBegin.end() - 1);
+        for (std::size_t i = 0; i < indicesCount; ++i) {
+            vertexTris[fill[inOutIndices[i]]++] = i / 3;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    std::vector<int> cachePosition(verticesCount, -1);
+    std::vector<float> vertexScore(verticesCount);
+    for (std::size_t v = 0; v < verticesCount; ++v) {
+        vertexScore[v] = scores.score(-1, remaining[v]);
+    }
+
+    std::vector<float> triScore(trisCount);
+    std::vector<bool> emitted(trisCount, false);
+    std::size_t best = 0;
+    for (std::size_t t = 0; t < trisCount; ++t) {
+        const std::size_t * tri = inOutIndices + t * 3;
+        triScore[t] = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+        if (triScore[t] > triScore[best]) {
+            best = t;
+        }
+    }
+
+    std::vector<std::size_t> result;
+    result.reserve(indicesCount);
+    std::vector<std::size_t> cache;
+    std::vector<std::size_t> newCache;
+    cache.reserve(cacheSize() + 3);
+    newCache.reserve(cacheSize() + 3);
+    std::size_t cursor = 0;
+
+    for (std::size_t step = 0; step < trisCount; ++step) {
+        if (best == npos) {
+            // the cache doesn't have vertices with the unused triangles.
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+        }
+
+        const std::size_t * tri = inOutIndices + best * 3;
+        result.insert(result.end(), tri, tri + 3);
+        emitted[best] = true;
+
+        newCache.clear();
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::size_t v = tri[i];
+            // remove the triangle from the active ones of the vertex.
+            const std::size_t begin = trisBegin[v];
+            const std::size_t end = begin + remaining[v];
+            for (std::size_t j = begin; j < end; ++j) {
+                if (vertexTris[j] == best) {
+                    std::swap(vertexTris[j], vertexTris[end - 1]);
+                    --remaining[v];
+                    break;
+                }
+            }
+            if (cachePosition[v] != -2) {
+                newCache.emplace_back(v);
+                cachePosition[v] = -2; // mark as added
+            }
+        }
+        for (const std::size_t v : cache) {
+            if (cachePosition[v] != -2) {
+                newCache.emplace_back(v);
+            }
+        }
+
+        //-------------------------------------------------------------------------
+        // update the scores of the cached and just evicted vertices and their triangles.
+
+        for (std::size_t i = 0; i < newCache.size(); ++i) {
+            const std::size_t v = newCache[i];
+            cachePosition[v] = i < cacheSize() ? int(i) : -1;
+            vertexScore[v] = scores.score(cachePosition[v], remaining[v]);
+        }
+
+        best = npos;
+        float bestScore = -1.0f;
+        for (const std::size_t v : newCache) {
+            const std::size_t begin = trisBegin[v];
+            const std::size_t end = begin + remaining[v];
+            for (std::size_t j = begin; j < end; ++j) {
+                const std::size_t t = vertexTris[j];
+                const std::size_t * ct = inOutIndices + t * 3;
+                triScore[t] = vertexScore[ct[0]] + vertexScore[ct[1]] + vertexScore[ct[2]];
+                if (triScore[t] > bestScore) {
+                    bestScore = triScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        if (newCache.size() > cacheSize()) {
+            newCache.resize(cacheSize());
+        }
+        cache.swap(newCache);
+    }
+
+    std::copy(result.begin(), result.end(), inOutIndices);
+}
+
+//-------------------------------------------------------------------------
+
+std::size_t VertexCacheAlg::cacheMisses(const std::size_t * indices, const std::size_t indicesCount, const std::size_t verticesCount) {
+    // FIFO cache: the vertex is in the cache if it was added less than cacheSize misses ago.
+    std::vector<std::size_t> addedAt(verticesCount, 0);
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i < indicesCount; ++i) {
+        const std::size_t v = indices[i];
+        assert(v < verticesCount);
+        if (addedAt[v] == 0 || misses - addedAt[v] >= cacheSize()) {
+            ++misses;
+            addedAt[v] = misses;
+        }
+    }
+    return misses;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include "xpln/Export.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Algorithms for the GPU post-transform vertex cache.
+ */
+class VertexCacheAlg {
+    VertexCacheAlg() = default;
+    ~VertexCacheAlg() = default;
+public:
+
+    //-------------------------------------------------------------------------
+    /// @{
+
+    /*!
+     * \details Size of the cache which is used for the optimization and for the misses calculation.
+     */
+    static constexpr std::size_t cacheSize() { return 32; }
+
+    /*!
+     * \details Reorders the triangles for the vertex cache locality (Tom Forsyth's linear-speed algorithm).
+     *          The triangles keep their vertices order so their winding isn't changed.
+     * \param [in, out] inOutIndices triangles, 3 indices for each one.
+     * \param [in] indicesCount must be multiple of 3.
+     * \param [in] verticesCount all the indices must be less than this value.
+     */
+    XpObjLib static void optimize(std::size_t * inOutIndices, std::size_t indicesCount, std::size_t verticesCount);
+
+    /*!
+     * \details Calculates the vertex cache misses with FIFO cache of the \link VertexCacheAlg::cacheSize \endlink.
+     *          ACMR (average cache miss ratio) is the misses count divided by the triangles count.
+     * \param [in] indices triangles, 3 indices for each one.
+     * \param [in] indicesCount
+     * \param [in] verticesCount all the indices must be less than this value.
+     * \return cache misses count.
+     */
+    XpObjLib static std::size_t cacheMisses(const std::size_t * indices, std::size_t indicesCount, std::size_t verticesCount);
+
+    /// @}
+    //-------------------------------------------------------------------------
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <exception>
+#include <system_error>
+#include <algorithm>
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Gets actual threads count.
+ * \param [in] threads requested count, 0 means hardware concurrency.
+ * \return Threads count that is always greater than 0.
+ */
+inline std::size_t actualThreadsCount(const std::size_t threads) {
+    if (threads != 0) {
+        return threads;
+    }
+    const std::size_t hw = std::thread::hardware_concurrency();
+    return hw != 0 ? hw : 1;
+}
+
+/*!
+ * \details Calls the function for each index in [0, count) by several threads.
+ *          The calling thread takes part in the work too,
+ *          so if the threads count is 1 no any threads are created.
+ *          The order of calls isn't defined.
+ * \note The first exception that is thrown by the function is re-thrown in the calling thread
+ *       after all the threads are finished.
+ * \param [in] count
+ * \param [in] threads 0 means hardware concurrency.
+ * \param [in] function void(std::size_t index)
+ */
+template<typename Function>
+void parallelFor(const std::size_t count, const std::size_t threads, const Function & function) {
+    const std::size_t workers = std::min(actualThreadsCount(threads), count);
+    if (workers < 2) {
+        for (std::size_t i = 0; i < count; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    const auto worker = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                function(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t i = 1; i < workers; ++i) {
+        try {
+            pool.emplace_back(worker);
+        }
+        catch (const std::system_error &) {
+            // the threads that are already created and the calling one will do the work.
+            break;
+        }
+    }
+    worker();
+    for (auto & t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <chrono>
+#include "xpln/obj/IOStatistic.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Adds the wall-clock and the CPU time of its scope to the phase time.
+ *          The time can be added earlier by stop(), for example before the statistic is copied.
+ */
+class PhaseTimer {
+public:
+
+    explicit PhaseTimer(IOPhaseTime & outTime)
+        : mTime(outTime),
+          mWallStart(std::chrono::steady_clock::now()),
+          mCpuStart(processCpuSec()) {}
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer & operator =(const PhaseTimer &) = delete;
+
+    ~PhaseTimer() {
+        stop();
+    }
+
+    void stop() {
+        if (mStopped) {
+            return;
+        }
+        mStopped = true;
+        const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - mWallStart;
+        mTime.pWallSec += wall.count();
+        mTime.pCpuSec += processCpuSec() - mCpuStart;
+    }
+
+    /*!
+     * \details CPU time of the process in seconds, it includes all the threads.
+     * \note std::clock isn't used because it returns the wall-clock time on Windows.
+     */
+    static double processCpuSec();
+
+private:
+
+    IOPhaseTime & mTime;
+    std::chrono::steady_clock::time_point mWallStart;
+    double mCpuStart;
+    bool mStopped = false;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -121,6 +121,10 @@ bool TMatrix::parity() const {
     return reinterpret_cast<const Mtx3*>(this)->isParity();
 }
 
+bool TMatrix::isIdentity() const {
+    return reinterpret_cast<const Mtx3*>(this)->isIdentity();
+}
+
 Point3 TMatrix::row(std::size_t i) const {
     return Point3((*reinterpret_cast<const Mtx3*>(this))(i, 0),
                   (*reinterpret_cast<const Mtx3*>(this))(i, 1),
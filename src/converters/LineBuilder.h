@@ -0,0 +1,309 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include "xpln/common/Point2.h"
+#include "xpln/common/Point3.h"
+#include "xpln/common/Color.h"
+#include "Defines.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Numbers formatting without streams, locale and heap allocations.
+ *          The result is the same as std::fixed stream formatting gives.
+ */
+class NumberFormat {
+public:
+
+    /*!
+     * \details Max length of the formatted number including sign, point and null-terminator.
+     */
+    static constexpr std::size_t maxLength() { return 64; }
+
+    /*!
+     * \details Writes decimal representation of the value.
+     * \param [out] out buffer with at least \link NumberFormat::maxLength \endlink size.
+     * \param [in] val
+     * \return Pointer to the symbol after the last written one, null-terminator isn't written.
+     */
+    static char * formatUInt(char * out, std::uint64_t val);
+
+    /*!
+     * \details Writes decimal representation of the value with fixed precision.
+     *          The value is rounded correctly (half to even) like printf's "%.*f" does.
+     * \param [out] out buffer with at least \link NumberFormat::maxLength \endlink size.
+     * \param [in] val
+     * \param [in] precision digits count after the point.
+     * \return Pointer to the symbol after the last written one, null-terminator isn't written.
+     */
+    static char * formatFixed(char * out, float val, std::uint8_t precision = PRECISION);
+
+private:
+
+    static const char * digitPairs() {
+        return "00010203040506070809"
+               "10111213141516171819"
+               "20212223242526272829"
+               "30313233343536373839"
+               "40414243444546474849"
+               "50515253545556575859"
+               "60616263646566676869"
+               "70717273747576777879"
+               "80818283848586878889"
+               "90919293949596979899";
+    }
+
+    static std::uint64_t powerOf10(const std::uint8_t power) {
+        static const std::uint64_t table[] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull,
+            100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull
+        };
+        return table[power];
+    }
+
+    static char * formatFallback(char * out, float val, std::uint8_t precision);
+    static char * formatDigits(char * out, std::uint64_t val, std::uint8_t count);
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Builder for one obj line.
+ *          The line is built in the internal fixed buffer,
+ *          the heap is used only if the line is too long (for example long object names).
+ */
+class LineBuilder {
+public:
+
+    //-------------------------------------------------------------------------
+
+    explicit LineBuilder(const std::uint8_t precision = PRECISION)
+        : mPrecision(precision) {}
+
+    LineBuilder(const LineBuilder &) = delete;
+    LineBuilder & operator=(const LineBuilder &) = delete;
+
+    //-------------------------------------------------------------------------
+
+    LineBuilder & add(const char * str) { return add(str, std::strlen(str)); }
+    LineBuilder & add(const std::string & str) { return add(str.data(), str.size()); }
+    LineBuilder & add(const char ch) { return add(&ch, 1); }
+
+    LineBuilder & add(const float val) {
+        char tmp[NumberFormat::maxLength()];
+        return add(tmp, std::size_t(NumberFormat::formatFixed(tmp, val, mPrecision) - tmp));
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+    LineBuilder & add(const T val) {
+        char tmp[NumberFormat::maxLength()];
+        char * ptr = tmp;
+        if (val < T(0)) {
+            *ptr++ = '-';
+            ptr = NumberFormat::formatUInt(ptr, std::uint64_t(0) - std::uint64_t(val));
+        }
+        else {
+            ptr = NumberFormat::formatUInt(ptr, std::uint64_t(val));
+        }
+        return add(tmp, std::size_t(ptr - tmp));
+    }
+
+    /*! \details Adds "x y z". */
+    LineBuilder & add(const Point3 & p) {
+        return add(p.x).add(' ').add(p.y).add(' ').add(p.z);
+    }
+
+    /*! \details Adds "x y". */
+    LineBuilder & add(const Point2 & p) {
+        return add(p.x).add(' ').add(p.y);
+    }
+
+    /*! \details Adds "r g b a". */
+    LineBuilder & add(const Color & c) {
+        return add(c.red()).add(' ').add(c.green()).add(' ').add(c.blue()).add(' ').add(c.alpha());
+    }
+
+    LineBuilder & add(const char * str, const std::size_t length) {
+        if (mHeap.empty() && mSize + length < sizeof(mBuffer)) {
+            std::memcpy(mBuffer + mSize, str, length);
+            mSize += length;
+            return *this;
+        }
+        if (mHeap.empty()) {
+            mHeap.assign(mBuffer, mSize);
+        }
+        mHeap.append(str, length);
+        return *this;
+    }
+
+    //-------------------------------------------------------------------------
+
+    const char * c_str() {
+        if (!mHeap.empty()) {
+            return mHeap.c_str();
+        }
+        mBuffer[mSize] = '\0';
+        return mBuffer;
+    }
+
+    std::size_t size() const {
+        return mHeap.empty() ? mSize : mHeap.size();
+    }
+
+    void clear() {
+        mSize = 0;
+        mHeap.clear();
+    }
+
+    //-------------------------------------------------------------------------
+
+private:
+
+    char mBuffer[256];
+    std::size_t mSize = 0;
+    std::string mHeap;
+    std::uint8_t mPrecision;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+inline char * NumberFormat::formatUInt(char * out, std::uint64_t val) {
+    char tmp[24];
+    char * ptr = tmp + sizeof(tmp);
+    const char * pairs = digitPairs();
+    while (val >= 100) {
+        const std::size_t idx = std::size_t(val % 100) * 2;
+        val /= 100;
+        *--ptr = pairs[idx + 1];
+        *--ptr = pairs[idx];
+    }
+    if (val < 10) {
+        *--ptr = char('0' + val);
+    }
+    else {
+        const std::size_t idx = std::size_t(val) * 2;
+        *--ptr = pairs[idx + 1];
+        *--ptr = pairs[idx];
+    }
+    const std::size_t length = std::size_t(tmp + sizeof(tmp) - ptr);
+    std::memcpy(out, ptr, length);
+    return out + length;
+}
+
+inline char * NumberFormat::formatDigits(char * out, std::uint64_t val, const std::uint8_t count) {
+    for (std::uint8_t i = count; i > 0; --i) {
+        out[i - 1] = char('0' + val % 10);
+        val /= 10;
+    }
+    return out + count;
+}
+
+inline char * NumberFormat::formatFallback(char * out, const float val, const std::uint8_t precision) {
+    const int length = std::snprintf(out, maxLength(), "%.*f", int(precision), double(val));
+    if (length < 0) {
+        return out;
+    }
+    return out + std::min(std::size_t(length), maxLength() - 1);
+}
+
+inline char * NumberFormat::formatFixed(char * out, const float val, const std::uint8_t precision) {
+    if (precision > 9 || !std::isfinite(val)) {
+        return formatFallback(out, val, precision);
+    }
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    const bool negative = (bits >> 31) != 0;
+    const std::uint32_t exponent = (bits >> 23) & 0xFF;
+    const std::uint32_t fraction = bits & 0x7FFFFF;
+
+    // The value is mantissa * 2^power exactly.
+    const std::uint64_t mantissa = exponent == 0 ? fraction : (fraction | 0x800000);
+    const int power = exponent == 0 ? -149 : int(exponent) - 150;
+
+    // The scaled value is less than 2^54, so it is calculated
+    // and rounded with integers without any precision loss.
+    const std::uint64_t scaled = mantissa * powerOf10(precision);
+    std::uint64_t rounded;
+    if (power >= 0) {
+        if (power > 9) {
+            return formatFallback(out, val, precision);
+        }
+        rounded = scaled << power;
+    }
+    else if (power <= -64) {
+        rounded = 0;
+    }
+    else {
+        const unsigned shift = unsigned(-power);
+        rounded = scaled >> shift;
+        const std::uint64_t reminder = scaled & ((std::uint64_t(1) << shift) - 1);
+        const std::uint64_t half = std::uint64_t(1) << (shift - 1);
+        if (reminder > half || (reminder == half && (rounded & 1))) {
+            ++rounded;
+        }
+    }
+
+    if (negative) {
+        *out++ = '-';
+    }
+    const std::uint64_t divider = powerOf10(precision);
+    out = formatUInt(out, rounded / divider);
+    if (precision != 0) {
+        *out++ = '.';
+        out = formatDigits(out, rounded % divider, precision);
+    }
+    return out;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -29,6 +29,7 @@
 
 #include "ObjString.h"
 #include "converters/StringStream.h"
+#include "converters/LineBuilder.h"
 
 #include "common/AttributeNames.h"
 
@@ -56,26 +57,26 @@ namespace xobj {
 /**************************************************************************************************/
 
 void printObj(const MeshVertex & vertex, AbstractWriter & writer, const bool isTree) {
-    StringStream out;
-    out << MESH_VT << " " << vertex.pPosition.toString(PRECISION) << "  ";
+    LineBuilder out;
+    out.add(MESH_VT).add(' ').add(vertex.pPosition).add("  ");
 
     if (isTree)
-        out << 0.0f << " " << 1.0f << " " << 0.0f;
+        out.add(Point3(0.0f, 1.0f, 0.0f));
     else
-        out << vertex.pNormal.normalized().toString(PRECISION);
+        out.add(vertex.pNormal.normalized());
 
-    out << "  " << vertex.pTexture.toString(PRECISION);
-    writer.printLine(out.str());
+    out.add("  ").add(vertex.pTexture);
+    writer.printLine(out.c_str());
 }
 
 void printObj(const LineVertex & vertex, AbstractWriter & writer) {
-    StringStream out;
-    out << VLINE
-            << " " << vertex.pPosition.toString(PRECISION)
-            << " " << vertex.pColor.red()
-            << " " << vertex.pColor.green()
-            << " " << vertex.pColor.blue();
-    writer.printLine(out.str());
+    LineBuilder out;
+    out.add(VLINE)
+       .add(' ').add(vertex.pPosition)
+       .add(' ').add(vertex.pColor.red())
+       .add(' ').add(vertex.pColor.green())
+       .add(' ').add(vertex.pColor.blue());
+    writer.printLine(out.c_str());
 }
 
 /**************************************************************************************************/
@@ -119,75 +120,76 @@ void printObj(const ObjDummy & obj, AbstractWriter & writer, const bool printNam
 /**************************************************************************************************/
 
 void printObj(const ObjLightCustom & obj, AbstractWriter & writer, const bool printName) {
-    StringStream out;
+    LineBuilder out;
     if (printName) {
-        out << "## " << obj.objectName() << std::endl;
+        out.add("## ").add(obj.objectName()).add('\n');
     }
-    out << LIGHT_CUSTOM
-            << " " << obj.position().toString(PRECISION)
-            << " " << obj.color().toString(PRECISION)
-            << " " << obj.size()
-            << " " << obj.textureRect().point1().toString(PRECISION)
-            << " " << obj.textureRect().point2().toString(PRECISION)
-            << " " << (obj.dataRef().empty() ? "none" : writer.actualDataref(obj.dataRef()).c_str());
-    writer.printLine(out.str());
+    const RectangleI textureRect = obj.textureRect();
+    out.add(LIGHT_CUSTOM)
+       .add(' ').add(obj.position())
+       .add(' ').add(obj.color())
+       .add(' ').add(obj.size())
+       .add(' ').add(textureRect.point1())
+       .add(' ').add(textureRect.point2())
+       .add(' ').add(obj.dataRef().empty() ? std::string("none") : writer.actualDataref(obj.dataRef()));
+    writer.printLine(out.c_str());
 }
 
 //-------------------------------------------------------------------------
 
 void printObj(const ObjLightNamed & obj, AbstractWriter & writer, const bool printName) {
-    StringStream out;
+    LineBuilder out;
     if (printName) {
-        out << "## " << obj.objectName() << std::endl;
+        out.add("## ").add(obj.objectName()).add('\n');
     }
-    out << LIGHT_NAMED
-            << " " << obj.name()
-            << " " << obj.position().toString(PRECISION);
-    writer.printLine(out.str());
+    out.add(LIGHT_NAMED)
+       .add(' ').add(obj.name())
+       .add(' ').add(obj.position());
+    writer.printLine(out.c_str());
 }
 
 //-------------------------------------------------------------------------
 
 void printObj(const ObjLightParam & obj, AbstractWriter & writer, const bool printName) {
-    StringStream out;
+    LineBuilder out;
     if (printName) {
-        out << "## " << obj.objectName() << std::endl;
+        out.add("## ").add(obj.objectName()).add('\n');
     }
-    out << LIGHT_PARAM
-            << " " << obj.name()
-            << " " << obj.position().toString(PRECISION)
-            << " " << obj.params();
-    writer.printLine(out.str());
+    out.add(LIGHT_PARAM)
+       .add(' ').add(obj.name())
+       .add(' ').add(obj.position())
+       .add(' ').add(obj.params());
+    writer.printLine(out.c_str());
 }
 
 //-------------------------------------------------------------------------
 
 void printObj(const ObjLightPoint & obj, AbstractWriter & writer, const bool printName) {
-    StringStream out;
+    LineBuilder out;
     if (printName) {
-        out << "## " << obj.objectName() << std::endl;
+        out.add("## ").add(obj.objectName()).add('\n');
     }
     const Color & c = obj.color();
-    out << VLIGHT << " " << obj.position().toString(PRECISION) << " "
-            << c.red() << " " << c.green() << " " << c.blue();
-    writer.printLine(out.str());
+    out.add(VLIGHT).add(' ').add(obj.position()).add(' ')
+       .add(c.red()).add(' ').add(c.green()).add(' ').add(c.blue());
+    writer.printLine(out.c_str());
 }
 
 //-------------------------------------------------------------------------
 
 void printObj(const ObjLightSpillCust & obj, AbstractWriter & writer, const bool printName) {
-    StringStream out;
+    LineBuilder out;
     if (printName) {
-        out << "## " << obj.objectName() << std::endl;
+        out.add("## ").add(obj.objectName()).add('\n');
     }
-    out << LIGHT_SPILL_CUSTOM
-            << " " << obj.position().toString(PRECISION)
-            << " " << obj.color().toString(PRECISION)
-            << " " << obj.size()
-            << " " << obj.direction().toString(PRECISION)
-            << " " << obj.semiRaw()
-            << " " << (obj.dataRef().empty() ? "none" : writer.actualDataref(obj.dataRef()).c_str());
-    writer.printLine(out.str());
+    out.add(LIGHT_SPILL_CUSTOM)
+       .add(' ').add(obj.position())
+       .add(' ').add(obj.color())
+       .add(' ').add(obj.size())
+       .add(' ').add(obj.direction())
+       .add(' ').add(obj.semiRaw())
+       .add(' ').add(obj.dataRef().empty() ? std::string("none") : writer.actualDataref(obj.dataRef()));
+    writer.printLine(out.c_str());
 }
 
 /**************************************************************************************************/
@@ -55,7 +55,25 @@ IOStatistic::IOStatistic()
       pTrisManipCount(0),
       pTrisAttrCount(0),
 
-      pAnimAttrCount(0) { }
+      pAnimAttrCount(0),
+
+      pOptWeldedVerticesCount(0),
+      pOptUnusedVerticesCount(0),
+      pOptDegenerateFacesCount(0),
+      pOptAcmrBefore(0.0f),
+      pOptAcmrAfter(0.0f),
+      pOptTrisAttrAvoidedCount(0),
+      pOptCoalescedObjCount(0),
+      pOptEmptyAnimCount(0),
+      pOptTransKeysRemovedCount(0),
+      pOptRotateKeysRemovedCount(0),
+      pOptAnimRemovedCount(0),
+      pOptMergedLodsCount(0),
+      pOptSharedFacesCount(0),
+
+      pBytesWritten(0),
+      pBytesRead(0),
+      pPeakBufferBytes(0) { }
 
 /**************************************************************************************************/
 //////////////////////////////////////////* Functions */////////////////////////////////////////////
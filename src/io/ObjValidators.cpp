@@ -123,7 +123,7 @@ bool checkParameters(const ObjMain & mainObj, const std::string & prefix) {
 
 bool checkParameters(const ObjMesh & obj, const std::string & prefix) {
     bool result = true;
-    if (obj.pVertices.empty()) {
+    if (obj.verticesCount() == 0) {
         result = false;
         LError << prefix << " - Doesn't have any vertices.";
     }
@@ -133,7 +133,7 @@ bool checkParameters(const ObjMesh & obj, const std::string & prefix) {
         LError << prefix << " - Doesn't have any faces.";
     }
     {
-        std::vector<bool> vertUsed(obj.pVertices.size(), false);
+        std::vector<bool> vertUsed(obj.verticesCount(), false);
         const size_t vertSize = vertUsed.size();
         for (size_t i = 0; i < obj.pFaces.size(); ++i) {
             const MeshFace & currFace = obj.pFaces[i];
@@ -0,0 +1,255 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Numbers parsing without streams, locale and heap allocations.
+ *          It is the opposite of the NumberFormat.
+ */
+class NumberParse {
+public:
+
+    /*!
+     * \details Parses decimal representation of the float value, the exponent is supported.
+     *          The result is rounded correctly (half to even) like strtof does in "C" locale.
+     * \details The most of the values are calculated with one double operation,
+     *          the stream is used only for the values with too many digits or too big exponent
+     *          and for the rare cases when the double result can't be rounded to float correctly.
+     * \param [in] begin
+     * \param [in] end
+     * \param [out] outVal 0 if there are no digits.
+     * \return Pointer to the symbol after the last parsed one.
+     */
+    static const std::uint8_t * parseFloat(const std::uint8_t * begin, const std::uint8_t * end, float & outVal);
+
+private:
+
+    static bool isDigit(const std::uint8_t ch) {
+        return std::uint8_t(ch - '0') < 10;
+    }
+
+    static double powerOf10(const int power) {
+        static const double table[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return table[power];
+    }
+
+    static std::uint64_t load8(const std::uint8_t * ptr) {
+        std::uint64_t val;
+        std::memcpy(&val, ptr, sizeof(val));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        val = __builtin_bswap64(val);
+#endif
+        return val;
+    }
+
+    /*! \details Checks that all 8 bytes are ascii digits. */
+    static bool isEightDigits(const std::uint64_t val) {
+        return ((val & 0xF0F0F0F0F0F0F0F0ull) |
+                (((val + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    /*! \details Converts 8 ascii digits to the number at once (SWAR). */
+    static std::uint32_t parseEightDigits(std::uint64_t val) {
+        val -= 0x3030303030303030ull;
+        val = (val * 10) + (val >> 8);
+        val = (((val & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+               (((val >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+        return std::uint32_t(val);
+    }
+
+    static bool toFloat(std::uint64_t mantissa, int power, bool negative, float & outVal);
+    static float parseFallback(const std::uint8_t * begin, const std::uint8_t * end);
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+inline const std::uint8_t * NumberParse::parseFloat(const std::uint8_t * begin, const std::uint8_t * end, float & outVal) {
+    const std::uint8_t * ptr = begin;
+    bool negative = false;
+    if (ptr != end && (*ptr == '-' || *ptr == '+')) {
+        negative = *ptr == '-';
+        ++ptr;
+    }
+
+    // Up to 19 significant digits are accumulated, the rest only moves the power.
+    const int maxDigits = 19;
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int power = 0;
+    bool truncated = false;
+    bool hasDigits = false;
+
+    while (ptr != end && *ptr == '0') {
+        hasDigits = true;
+        ++ptr;
+    }
+    for (; ptr != end && isDigit(*ptr); ++ptr) {
+        hasDigits = true;
+        if (digits < maxDigits) {
+            mantissa = mantissa * 10 + std::uint64_t(*ptr - '0');
+            ++digits;
+        }
+        else {
+            truncated = truncated || *ptr != '0';
+            ++power;
+        }
+    }
+
+    if (ptr != end && *ptr == '.') {
+        ++ptr;
+        if (digits == 0) {
+            for (; ptr != end && *ptr == '0'; ++ptr) {
+                hasDigits = true;
+                --power;
+            }
+        }
+        // The writer prints the fixed precision, so the long digits runs are usual.
+        while (digits + 8 <= maxDigits && end - ptr >= 8) {
+            const std::uint64_t chunk = load8(ptr);
+            if (!isEightDigits(chunk)) {
+                break;
+            }
+            hasDigits = true;
+            mantissa = mantissa * 100000000ull + parseEightDigits(chunk);
+            digits += 8;
+            power -= 8;
+            ptr += 8;
+        }
+        for (; ptr != end && isDigit(*ptr); ++ptr) {
+            hasDigits = true;
+            if (digits < maxDigits) {
+                mantissa = mantissa * 10 + std::uint64_t(*ptr - '0');
+                ++digits;
+                --power;
+            }
+            else {
+                truncated = truncated || *ptr != '0';
+            }
+        }
+    }
+
+    if (!hasDigits) {
+        outVal = 0.0f;
+        return ptr;
+    }
+
+    if (ptr != end && (*ptr == 'e' || *ptr == 'E')) {
+        const std::uint8_t * expPtr = ptr + 1;
+        bool expNegative = false;
+        if (expPtr != end && (*expPtr == '-' || *expPtr == '+')) {
+            expNegative = *expPtr == '-';
+            ++expPtr;
+        }
+        if (expPtr != end && isDigit(*expPtr)) {
+            int exponent = 0;
+            for (; expPtr != end && isDigit(*expPtr); ++expPtr) {
+                // Any float is out of range long before this limit.
+                if (exponent < 100000) {
+                    exponent = exponent * 10 + (*expPtr - '0');
+                }
+            }
+            power += expNegative ? -exponent : exponent;
+            ptr = expPtr;
+        }
+    }
+
+    if (truncated || !toFloat(mantissa, power, negative, outVal)) {
+        outVal = parseFallback(begin, ptr);
+    }
+    return ptr;
+}
+
+/*!
+ * \details Clinger's fast path. The mantissa and the power of 10 are exact doubles,
+ *          so the double result is rounded correctly. It can be rounded to float
+ *          one more time without an error if it isn't exactly in the middle
+ *          between two floats: the true value is on the same side of the middle then.
+ */
+inline bool NumberParse::toFloat(const std::uint64_t mantissa, const int power, const bool negative, float & outVal) {
+    if (mantissa == 0) {
+        outVal = negative ? -0.0f : 0.0f;
+        return true;
+    }
+    if (mantissa > (std::uint64_t(1) << 53) || power < -22 || power > 22) {
+        return false;
+    }
+    double val = double(mantissa);
+    val = power < 0 ? val / powerOf10(-power) : val * powerOf10(power);
+    // The subnormal floats have less precision, they are rare so the fallback is used.
+    if (val < double(std::numeric_limits<float>::min()) || val > double(std::numeric_limits<float>::max())) {
+        return false;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    const std::uint64_t lowBits = (std::uint64_t(1) << 29) - 1;
+    if ((bits & lowBits) == (std::uint64_t(1) << 28)) {
+        return false;
+    }
+    outVal = float(negative ? -val : val);
+    return true;
+}
+
+inline float NumberParse::parseFallback(const std::uint8_t * begin, const std::uint8_t * end) {
+    std::istringstream stream(std::string(begin, end));
+    stream.imbue(std::locale::classic());
+    float val = 0.0f;
+    stream >> val;
+    // The stream gives the max value for the overflow, strtof gives the infinity.
+    if (stream.fail() && (val == std::numeric_limits<float>::max() || val == -std::numeric_limits<float>::max())) {
+        return val > 0.0f ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+    }
+    return val;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -0,0 +1,232 @@
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstring>
+#include "ObjKeywords.h"
+#include "common/AttributeNames.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+struct Keyword {
+    const char * mName;
+    ObjKeywords::eGroup mGroup;
+};
+
+// The keywords which are read by the trying functions themselves
+// (for example ATTR_TRANS_KEY after ATTR_TRANS_BEGIN) aren't here.
+constexpr Keyword gKeywords[] = {
+    {MESH_TRIS, ObjKeywords::GROUP_TRIS},
+
+    {ATTR_SHADOW, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_SHADOW, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_DRAPED, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_DRAPED, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_DRAW_ENABLE, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_DRAW_DISABLE, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_SOLID_CAMERA, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_SOLID_CAMERA, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_BLEND, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_BLEND, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_SHADOW_BLEND, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_COCKPIT, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_COCKPIT_REGION, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_COCKPIT, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_HARD, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_HARD_DECK, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_NO_HARD, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_LIGHT_LEVEL, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_LIGHT_LEVEL_RESET, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_POLY_OS, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_SHINY_RAT, ObjKeywords::GROUP_ATTRIBUTE},
+    {ATTR_RESET, ObjKeywords::GROUP_ATTRIBUTE},
+
+    {ATTR_MANIP_NONE, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_AXIS_KNOB, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_AXIS_SWITCH_LEFT_RIGHT, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_AXIS_SWITCH_UP_DOWN, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_AXIS, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_KNOB, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_KNOB2, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_SWITCH_LEFT_RIGHT, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_SWITCH_LEFT_RIGHT2, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_SWITCH_UP_DOWN, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_COMMAND_SWITCH_UP_DOWN2, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_DELTA, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_DRAG_AXIS, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_DRAG_ROTATE, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_DRAG_AXIS_PIX, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_DRAG_XY, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_NOOP, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_PUSH, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_RADIO, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_TOGGLE, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_WRAP, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_WHEEL, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_KEYFRAME, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_AXIS_DETENTED, ObjKeywords::GROUP_MANIPULATOR},
+    {ATTR_MANIP_AXIS_DETENT_RANGE, ObjKeywords::GROUP_MANIPULATOR},
+
+    {ATTR_GLOBAL_BLEND_GLASS, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_NORMAL_METALNESS, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_TEXTURE, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_TEXTURE_LIT, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_TEXTURE_NORMAL, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_WET, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_DRY, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_TINT, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_TILTED, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_NO_BLEND, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_SPECULAR, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_NO_SHADOW, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_LOD_DRAPED, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_COCKPIT_LIT, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_LAYER_GROUP, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_SLOPE_LIMIT, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_SHADOW_BLEND, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_COCKPIT_REGION, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_SLUNG_LOAD_WEIGHT, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_LAYER_GROUP_DRAPED, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+    {ATTR_GLOBAL_DEBUG, ObjKeywords::GROUP_GLOBAL_ATTRIBUTE},
+
+    {ATTR_ANIM_BEGIN, ObjKeywords::GROUP_ANIM_BEGIN},
+
+    {ATTR_ANIM_END, ObjKeywords::GROUP_ANIM_END},
+
+    {ATTR_TRANS, ObjKeywords::GROUP_TRANSLATE_ANIM},
+
+    {ATTR_ROTATE, ObjKeywords::GROUP_ROTATE_ANIM},
+
+    {ATTR_TRANS_BEGIN, ObjKeywords::GROUP_TRANSLATE_KEYS_ANIM},
+
+    {ATTR_ROTATE_BEGIN, ObjKeywords::GROUP_ROTATE_KEYS_ANIM},
+
+    {ATTR_ANIM_HIDE, ObjKeywords::GROUP_HIDE_ANIM},
+
+    {ATTR_ANIM_SHOW, ObjKeywords::GROUP_SHOW_ANIM},
+
+    {ATTR_LOD, ObjKeywords::GROUP_LOD},
+};
+
+constexpr std::size_t gKeywordsCount = sizeof(gKeywords) / sizeof(gKeywords[0]);
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * FNV-1a with the seed which gives no collisions for the keywords above.
+ * If a keyword is added and the static_assert below fails,
+ * the seed must be changed to the one which gives no collisions again.
+ */
+constexpr std::uint32_t gSeed = 2166136854u;
+constexpr unsigned gSlotsBits = 9;
+constexpr std::size_t gSlotsCount = std::size_t(1) << gSlotsBits;
+
+constexpr std::size_t slotOf(const char * str, const std::size_t size) {
+    std::uint32_t hash = gSeed;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ std::uint8_t(str[i])) * 16777619u;
+    }
+    return std::size_t(hash >> (32 - gSlotsBits));
+}
+
+constexpr std::size_t lengthOf(const char * str) {
+    std::size_t size = 0;
+    while (str[size] != '\0') {
+        ++size;
+    }
+    return size;
+}
+
+static_assert(gKeywordsCount < 255, "The slot stores the keyword index + 1 as uint8_t");
+
+/*!
+ * \details Slot keeps the keyword index + 1, 0 means the empty slot.
+ */
+struct SlotsTable {
+    std::uint8_t mSlots[gSlotsCount];
+    bool mPerfect;
+
+    constexpr SlotsTable()
+        : mSlots(),
+          mPerfect(true) {
+        for (std::size_t i = 0; i < gKeywordsCount; ++i) {
+            const std::size_t slot = slotOf(gKeywords[i].mName, lengthOf(gKeywords[i].mName));
+            if (mSlots[slot] != 0) {
+                mPerfect = false;
+            }
+            mSlots[slot] = std::uint8_t(i + 1);
+        }
+    }
+};
+
+constexpr SlotsTable gTable;
+static_assert(gTable.mPerfect, "The keywords hash has collisions, change the seed");
+
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+ObjKeywords::eGroup ObjKeywords::find(const StringRef & keyword) {
+    if (keyword.empty()) {
+        return GROUP_UNKNOWN;
+    }
+    const std::uint8_t slot = gTable.mSlots[slotOf(keyword.data(), keyword.size())];
+    if (slot == 0) {
+        return GROUP_UNKNOWN;
+    }
+    const Keyword & candidate = gKeywords[slot - 1];
+    if (std::strncmp(candidate.mName, keyword.data(), keyword.size()) != 0 || candidate.mName[keyword.size()] != '\0') {
+        return GROUP_UNKNOWN;
+    }
+    return candidate.mGroup;
+}
+
+std::size_t ObjKeywords::count() {
+    return gKeywordsCount;
+}
+
+const char * ObjKeywords::keyword(const std::size_t index) {
+    return gKeywords[index].mName;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
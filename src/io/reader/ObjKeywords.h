@@ -0,0 +1,99 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include "xpln/utils/StringRef.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details The keywords which begin the lines after the geometry section.
+ *          Each keyword is mapped to the group which is read by one ObjReader's function,
+ *          so the reader extracts the keyword once and calls only that function
+ *          instead of trying all of them.
+ * \details The lookup uses the perfect hash table which is built at compile time.
+ */
+class ObjKeywords {
+public:
+
+    //-------------------------------------------------------------------------
+
+    enum eGroup : std::uint8_t {
+        GROUP_UNKNOWN = 0, //!< The line isn't read, for example a comment or not supported keyword.
+        GROUP_TRIS,
+        GROUP_ATTRIBUTE,
+        GROUP_MANIPULATOR,
+        GROUP_GLOBAL_ATTRIBUTE,
+        GROUP_ANIM_BEGIN,
+        GROUP_ANIM_END,
+        GROUP_TRANSLATE_ANIM,
+        GROUP_ROTATE_ANIM,
+        GROUP_TRANSLATE_KEYS_ANIM,
+        GROUP_ROTATE_KEYS_ANIM,
+        GROUP_HIDE_ANIM,
+        GROUP_SHOW_ANIM,
+        GROUP_LOD,
+    };
+
+    //-------------------------------------------------------------------------
+
+    /*!
+     * \param [in] keyword
+     * \return The group of the keyword or GROUP_UNKNOWN.
+     */
+    static eGroup find(const StringRef & keyword);
+
+    /*!
+     * \details It is for the tests.
+     * \return Count of the known keywords.
+     */
+    static std::size_t count();
+
+    /*!
+     * \details It is for the tests.
+     * \param [in] index less than \link ObjKeywords::count \endlink
+     * \return The keyword.
+     */
+    static const char * keyword(std::size_t index);
+
+    //-------------------------------------------------------------------------
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
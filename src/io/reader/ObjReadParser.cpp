@@ -28,7 +28,9 @@
 */
 
 #include "ObjReadParser.h"
+#include <fstream>
 #include "common/Logger.h"
+#include "sts/string/StringUtils.h"
 
 namespace xobj {
 
@@ -36,16 +38,18 @@ namespace xobj {
 ////////////////////////////////////* Constructors/Destructor */////////////////////////////////////
 /**************************************************************************************************/
 
-ObjReadParser::ObjReadParser(const std::string & filePath)
-    : mMemCurr(nullptr),
-      mMemStart(nullptr),
-      mMemEnd(nullptr) {
-
+ObjReadParser::ObjReadParser(const Path & filePath) {
     if (!filePath.empty()) {
         readFile(filePath);
     }
 }
 
+ObjReadParser::ObjReadParser(const uint8_t * begin, const uint8_t * end)
+    : mIsValid(true),
+      mMemCurr(begin),
+      mMemStart(begin),
+      mMemEnd(end) {}
+
 ObjReadParser::~ObjReadParser() {
     close();
 }
@@ -54,48 +58,60 @@ ObjReadParser::~ObjReadParser() {
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
-bool ObjReadParser::readFile(const std::string & filePath) {
+bool ObjReadParser::readFile(const Path & filePath) {
     close();
-    FILE * file = fopen(filePath.data(), "rb");
-    if (!file) {
-        ULError << "File <" << filePath.data() << "> could not be read!";
-        return false;
+    if (mMapped.open(filePath) && mMapped.size() != 0) {
+        mMemStart = reinterpret_cast<const uint8_t *>(mMapped.data());
+        mMemEnd = mMemStart + mMapped.size();
     }
+    else {
+        // The special files and pipes may report 0 size
+        // or can't be mapped at all, so they are read to the buffer.
+        mMapped.close();
+        if (!readBuffered(filePath)) {
+            // todo sts::toMbString may work incorrectly with unicode.
+            ULError << "File <" << sts::toMbString(filePath) << "> could not be read!";
+            return false;
+        }
+    }
+    mMemCurr = mMemStart;
+    mIsValid = true;
+    return true;
+}
 
-    const unsigned filesize = fileSize(file);
-
-    mMemStart = static_cast<uint8_t *>(malloc(filesize));
-    if (mMemStart == nullptr) {
-        LError << "Memory could not be allocated!";
-        fclose(file);
+bool ObjReadParser::readBuffered(const Path & filePath) {
+    // It is used for the sources which can't be mapped,
+    // their size may be unknown so they are read by blocks.
+    std::ifstream file(filePath, std::ios_base::in | std::ios_base::binary);
+    if (!file) {
         return false;
     }
-    if (fread(mMemStart, 1, filesize, file) != filesize) {
-        close();
-        fclose(file);
-        LError << "Size of the allocated memory is incorrect!";
+    const std::size_t blockSize = 1024 * 1024;
+    std::size_t size = 0;
+    while (file) {
+        mBuffer.resize(size + blockSize);
+        file.read(reinterpret_cast<char *>(mBuffer.data() + size), static_cast<std::streamsize>(blockSize));
+        size += static_cast<std::size_t>(file.gcount());
+    }
+    if (file.bad()) {
+        mBuffer.clear();
         return false;
     }
-    mMemCurr = mMemStart;
-    mMemEnd = mMemStart + filesize;
-    fclose(file);
+    mBuffer.resize(size);
+    mMemStart = mBuffer.data();
+    mMemEnd = mMemStart + size;
     return true;
 }
 
 void ObjReadParser::close() {
-    if (mMemStart) {
-        free(mMemStart);
-        mMemStart = nullptr;
-        mMemCurr = nullptr;
-        mMemEnd = nullptr;
-    }
-}
-
-unsigned ObjReadParser::fileSize(FILE * file) {
-    fseek(file, 0L, SEEK_END);
-    const auto filesize = static_cast<unsigned>(ftell(file));
-    fseek(file, 0L, SEEK_SET);
-    return unsigned(filesize);
+    mMapped.close();
+    mBuffer.clear();
+    mBuffer.shrink_to_fit();
+    mMemStart = nullptr;
+    mMemCurr = nullptr;
+    mMemEnd = nullptr;
+    mIsValid = false;
+    mStack = std::stack<const uint8_t*>();
 }
 
 /**************************************************************************************************/
@@ -31,9 +31,14 @@
 
 #include <string>
 #include <cstdint>
-#include <cmath>
+#include <cstddef>
 #include <cassert>
 #include <stack>
+#include <vector>
+#include "xpln/utils/Path.h"
+#include "common/MappedFile.h"
+#include "NumberParse.h"
+#include "xpln/utils/StringRef.h"
 
 namespace xobj {
 
@@ -43,8 +48,9 @@ namespace xobj {
 
 /*!
  * \details Class text parser.
- * \details Use constructor with file path or readFile() first, this methods reads specified file to the memory
- *          then you can use the methods for parsing. When you complete parsing use close() method,
+ * \details Use constructor with file path or readFile() first, this methods maps specified file to the memory
+ *          then you can use the methods for parsing. If the file can't be mapped it is read to the buffer.
+ *          When you complete parsing use close() method,
  *          it frees memory and after this method you can not use parsing methods.
  *          The method close() is calling by the destructor too.
  *          Use isEnd() for check you have read all data.
@@ -57,7 +63,16 @@ public:
 
     //-------------------------------------------------------------------------
 
-    explicit ObjReadParser(const std::string & filePath = "");
+    ObjReadParser() = default;
+    explicit ObjReadParser(const Path & filePath);
+
+    /*!
+     * \details Parser for the part of the data of another parser, the data isn't copied.
+     *          It is used for parsing the chunks by several threads.
+     * \param [in] begin
+     * \param [in] end
+     */
+    ObjReadParser(const uint8_t * begin, const uint8_t * end);
 
     ObjReadParser(const ObjReadParser &) = delete;
     ObjReadParser & operator =(const ObjReadParser &) = delete;
@@ -67,10 +82,16 @@ public:
     //-------------------------------------------------------------------------
     // Class initialization
 
-    bool readFile(const std::string & filePath);
+    bool readFile(const Path & filePath);
     bool isValid() const;
     void close();
 
+    /*! \details Size of the read data in bytes. */
+    std::size_t size() const { return std::size_t(mMemEnd - mMemStart); }
+
+    /*! \details True if the file is mapped, false if it is read to the buffer. */
+    bool isMapped() const { return mMapped.isOpen(); }
+
     //-------------------------------------------------------------------------
     // Parsing methods
 
@@ -78,7 +99,9 @@ public:
     std::string extractLine();
     std::string extractLineTilEol();
     std::string extractWord();
+    StringRef peekWord();
     int extractInt();
+    std::int64_t extractInt64();
     float extractFloat();
     bool isMatch(const char * inString, bool skipMatched = true);
     bool isEnd() const;
@@ -91,6 +114,15 @@ public:
     void pushPosition() const;
     void popPosition(bool apply);
 
+    const uint8_t * position() const { return mMemCurr; }
+    const uint8_t * endPosition() const { return mMemEnd; }
+
+    /*! \param [in] position must be in the range of the data. */
+    void setPosition(const uint8_t * position) {
+        assert(position >= mMemStart && position <= mMemEnd);
+        mMemCurr = position;
+    }
+
     //-------------------------------------------------------------------------
 
 private:
@@ -100,13 +132,17 @@ private:
     bool static isSpace(const uint8_t * byte);
     bool isComment() const;
 
-    static unsigned fileSize(FILE * file);
+    bool readBuffered(const Path & filePath);
+
+    mutable std::stack<const uint8_t*> mStack;
 
-    mutable std::stack<uint8_t*> mStack;
+    MappedFile mMapped;
+    std::vector<uint8_t> mBuffer;
+    bool mIsValid = false;
 
-    uint8_t * mMemCurr;
-    uint8_t * mMemStart;
-    uint8_t * mMemEnd;
+    const uint8_t * mMemCurr = nullptr;
+    const uint8_t * mMemStart = nullptr;
+    const uint8_t * mMemEnd = nullptr;
 
 };
 
@@ -170,23 +206,36 @@ inline std::string ObjReadParser::extractLine() {
 /*! \details Build a string from the current char to the end of the line (including trailing whitespace). */
 inline std::string ObjReadParser::extractLineTilEol() {
     assert(isValid());
-    uint8_t * start = mMemCurr;
+    const uint8_t * start = mMemCurr;
     while (!isEnd() && !isEol(mMemCurr))
         ++mMemCurr;
-    uint8_t * end = mMemCurr;
+    const uint8_t * end = mMemCurr;
     return std::string(start, end);
 }
 
 /*! \details Build a string of the first non-whitespace word. */
 inline std::string ObjReadParser::extractWord() {
     assert(isValid());
-    uint8_t * start = mMemCurr;
+    const uint8_t * start = mMemCurr;
     while (!isEnd() && !isSpace(mMemCurr) && !isEol(mMemCurr))
         ++mMemCurr;
-    uint8_t * end = mMemCurr;
+    const uint8_t * end = mMemCurr;
     return std::string(start, end);
 }
 
+/*!
+ * \details Skips white space and gives the next word without consuming it.
+ * \note The reference is valid while the file is open.
+ */
+inline StringRef ObjReadParser::peekWord() {
+    assert(isValid());
+    skipSpace();
+    const uint8_t * end = mMemCurr;
+    while (end != mMemEnd && !isSpace(end) && !isEol(end))
+        ++end;
+    return StringRef(reinterpret_cast<const char *>(mMemCurr), std::size_t(end - mMemCurr));
+}
+
 /*! \details Skips current line */
 inline void ObjReadParser::nextLine() {
     assert(isValid());
@@ -204,9 +253,14 @@ inline void ObjReadParser::skipWord() {
 
 /*! \details Extracts int */
 inline int ObjReadParser::extractInt() {
+    return static_cast<int>(extractInt64());
+}
+
+/*! \details Extracts 64-bit int, it is used for the counts and the indices. */
+inline std::int64_t ObjReadParser::extractInt64() {
     assert(isValid());
-    int retVal = 0;
-    int signMult = 1;
+    std::int64_t retVal = 0;
+    std::int64_t signMult = 1;
 
     if (!isEnd() && *mMemCurr == '-') {
         signMult = -1;
@@ -224,29 +278,13 @@ inline int ObjReadParser::extractInt() {
     return signMult * retVal;
 }
 
-/*! \details Extracts float */
+/*! \details Extracts float, the rest of the word is skipped if it is not a number. */
 inline float ObjReadParser::extractFloat() {
     assert(isValid());
-    float retVal = 0;
-    float signMult = 1.0f;
-    int decimals = 0;
-    int hasDecimal = false;
-
-    while (!isEnd() && !isSpace(mMemCurr) && !isEol(mMemCurr)) {
-        if (*mMemCurr == '-')
-            signMult = -1.0f;
-        else if (*mMemCurr == '+')
-            signMult = 1.0f;
-        else if (*mMemCurr == '.')
-            hasDecimal = true;
-        else {
-            retVal = (10 * retVal) + *mMemCurr - '0';
-            if (hasDecimal)
-                ++decimals;
-        }
-        ++mMemCurr;
-    }
-    return float(retVal / pow(10.0f, static_cast<float>(decimals)) * signMult);
+    float retVal = 0.0f;
+    mMemCurr = NumberParse::parseFloat(mMemCurr, mMemEnd, retVal);
+    skipWord();
+    return retVal;
 }
 
 //-------------------------------------------------------------------------
@@ -263,12 +301,12 @@ inline bool ObjReadParser::isMatch(const char * inString, const bool skipMatched
     skipSpace();
     if (!inString)
         return false;
-    uint8_t * storePosition = mMemCurr;
+    const uint8_t * storePosition = mMemCurr;
     while (!isEnd() && *mMemCurr == *inString && *inString != '\0') {
         ++mMemCurr;
         ++inString;
     }
-    if (*inString == '\0' && (isSpace(mMemCurr) || isEol(mMemCurr))) {
+    if (*inString == '\0' && (isEnd() || isSpace(mMemCurr) || isEol(mMemCurr))) {
         if (!skipMatched)
             mMemCurr = storePosition;
         return true;
@@ -280,7 +318,7 @@ inline bool ObjReadParser::isMatch(const char * inString, const bool skipMatched
 //-------------------------------------------------------------------------
 
 inline bool ObjReadParser::isValid() const {
-    return mMemStart != nullptr;
+    return mIsValid;
 }
 
 //-------------------------------------------------------------------------
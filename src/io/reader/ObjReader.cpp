@@ -27,12 +27,16 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <algorithm>
+#include <cstring>
 #include "sts/utilities/Compare.h"
 #include "ObjReader.h"
 #include "ObjReadParser.h"
+#include "ObjKeywords.h"
 #include "common/AttributeNames.h"
 #include "common/Logger.h"
-#include "sts/string/StringUtils.h"
+#include "common/PhaseTimer.h"
+#include "common/ParallelFor.h"
 
 #include "xpln/obj/attributes/AttrBlend.h"
 #include "xpln/obj/attributes/AttrDrapedLayerGroup.h"
@@ -84,10 +88,11 @@ bool ObjReader::readFile(ImportContext & context, ObjReaderListener & listener)
     ObjReader reader;
     listener.reset();
     reader.mObjParserListener = &listener;
+    reader.mStatistic = &context.statistic();
+    reader.mWorkerThreads = context.workerThreads();
     try {
-        // todo this path converting will work incorrectly for UNICODE path.
-        // It is a temporary solution.
-        return reader.readFile(sts::toMbString(context.objFile()));
+        PhaseTimer timer(context.statistic().pTimeTotal);
+        return reader.readFile(context.objFile());
     }
     catch (std::exception & e) {
         ULFatal << e.what();
@@ -95,13 +100,18 @@ bool ObjReader::readFile(ImportContext & context, ObjReaderListener & listener)
     }
 }
 
-bool ObjReader::readFile(const std::string & filePath) const {
+bool ObjReader::readFile(const Path & filePath) const {
+    PhaseTimer loadTimer(mStatistic->pTimeFileLoad);
     ObjReadParser * parser = new ObjReadParser(filePath);
     if (!parser->isValid()) {
         delete parser;
         return false;
     }
+    loadTimer.stop();
+    mStatistic->pBytesRead += parser->size();
+    mStatistic->pPeakBufferBytes = std::max(mStatistic->pPeakBufferBytes, parser->size());
 
+    PhaseTimer headerTimer(mStatistic->pTimeHeader);
     if (!readHeader(*parser)) {
         delete parser;
         return false;
@@ -127,20 +137,27 @@ bool ObjReader::readFile(const std::string & filePath) const {
         delete parser;
         return false;
     }
+    headerTimer.stop();
 
+    PhaseTimer geometryTimer(mStatistic->pTimeGeometry);
     ObjMesh::VertexList vertices(meshVertexCount);
     ObjReaderListener::FaceIndexArray idx(meshIdxCount);
     ObjReaderListener::Index currVertIndex = 0;
     ObjReaderListener::Index currIndicesIndex = 0;
 
-    while (!parser->isEnd()) {
-        if (!readVertex(*parser, vertices, currVertIndex)) {
-            readIndexes(*parser, idx, currIndicesIndex);
-        }
-        if (vertices.size() == currVertIndex && idx.size() == currIndicesIndex) {
-            break;
+    if (mWorkerThreads != 1) {
+        readGeometryParallel(*parser, vertices, idx, currVertIndex, currIndicesIndex);
+    }
+    else {
+        while (!parser->isEnd()) {
+            if (!readVertex(*parser, vertices, currVertIndex)) {
+                readIndexes(*parser, idx, currIndicesIndex);
+            }
+            if (vertices.size() == currVertIndex && idx.size() == currIndicesIndex) {
+                break;
+            }
+            parser->nextLine();
         }
-        parser->nextLine();
     }
 
     if (vertices.size() != currVertIndex) {
@@ -155,47 +172,64 @@ bool ObjReader::readFile(const std::string & filePath) const {
         return false;
     }
 
-    mObjParserListener->gotMeshVertices(vertices);
-    if (!idx.empty()) {
-        if (idx.size() % 3) {
-            ULError << "The obj file doesn't contain multiple of 3 index count.";
-            return false;
-        }
-        mObjParserListener->gotMeshFaces(idx);
-    }
-    else {
-        const ObjReaderListener::FaceIndexArray empty;
-        mObjParserListener->gotMeshFaces(empty);
+    geometryTimer.stop();
+    mStatistic->pMeshVerticesCount += vertices.size();
+    mStatistic->pMeshFacesCount += idx.size() / 3;
+
+    PhaseTimer interpretationTimer(mStatistic->pTimeInterpretation);
+    if (idx.size() % 3) {
+        ULError << "The obj file doesn't contain multiple of 3 index count.";
+        delete parser;
+        return false;
     }
+    mObjParserListener->gotMeshVertices(std::move(vertices));
+    mObjParserListener->gotMeshFaces(std::move(idx));
 
+    // The keyword is extracted once and only its reading function is called.
     while (!parser->isEnd()) {
-        if (readTris(*parser))
-            goto next;
-        if (readAttribute(*parser))
-            goto next;
-        if (readAnimBegin(*parser))
-            goto next;
-        if (readAnimEnd(*parser))
-            goto next;
-        if (readTranslateAnim(*parser))
-            goto next;
-        if (readRotateAnim(*parser))
-            goto next;
-        if (readTranslateKeysAnim(*parser))
-            goto next;
-        if (readRotateKeysAnim(*parser))
-            goto next;
-        if (readManipulators(*parser))
-            goto next;
-        if (readHideAnim(*parser))
-            goto next;
-        if (readShowAnim(*parser))
-            goto next;
-        if (readLod(*parser))
-            goto next;
-        if (readGlobalAttribute(*parser))
-            goto next;
-    next:
+        switch (ObjKeywords::find(parser->peekWord())) {
+            case ObjKeywords::GROUP_TRIS:
+                readTris(*parser);
+                break;
+            case ObjKeywords::GROUP_ATTRIBUTE:
+                readAttribute(*parser);
+                break;
+            case ObjKeywords::GROUP_MANIPULATOR:
+                readManipulators(*parser);
+                break;
+            case ObjKeywords::GROUP_GLOBAL_ATTRIBUTE:
+                readGlobalAttribute(*parser);
+                break;
+            case ObjKeywords::GROUP_ANIM_BEGIN:
+                readAnimBegin(*parser);
+                break;
+            case ObjKeywords::GROUP_ANIM_END:
+                readAnimEnd(*parser);
+                break;
+            case ObjKeywords::GROUP_TRANSLATE_ANIM:
+                readTranslateAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_ROTATE_ANIM:
+                readRotateAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_TRANSLATE_KEYS_ANIM:
+                readTranslateKeysAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_ROTATE_KEYS_ANIM:
+                readRotateKeysAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_HIDE_ANIM:
+                readHideAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_SHOW_ANIM:
+                readShowAnim(*parser);
+                break;
+            case ObjKeywords::GROUP_LOD:
+                readLod(*parser);
+                break;
+            case ObjKeywords::GROUP_UNKNOWN:
+                break;
+        }
         parser->nextLine();
     }
 
@@ -242,13 +276,13 @@ bool ObjReader::readCounts(ObjReadParser & parser,
     // POINT_COUNTS tris lines lites geometry indices
     if (parser.isMatch(POINT_COUNTS)) {
         parser.skipSpace();
-        outVertices = parser.extractInt();
+        outVertices = static_cast<size_t>(parser.extractInt64());
         parser.skipSpace();
-        outLines = parser.extractInt();
+        outLines = static_cast<size_t>(parser.extractInt64());
         parser.skipSpace();
-        outLites = parser.extractInt();
+        outLites = static_cast<size_t>(parser.extractInt64());
         parser.skipSpace();
-        outFaces = parser.extractInt();
+        outFaces = static_cast<size_t>(parser.extractInt64());
         return true;
     }
     return false;
@@ -257,24 +291,27 @@ bool ObjReader::readCounts(ObjReadParser & parser,
 bool ObjReader::readVertex(ObjReadParser & parser, ObjMesh::VertexList & outVert, ObjReaderListener::FaceIndex & inOutIndex) {
     // VT <x> <y> <z> <nx> <ny> <nz> <s> <t>
     if (parser.isMatch(MESH_VT)) {
+        // the extra vertices are counted but not stored, the caller reports the incorrect count.
+        MeshVertex extra;
+        MeshVertex & vertex = inOutIndex < outVert.size() ? outVert[inOutIndex] : extra;
         parser.skipSpace();
-        outVert[inOutIndex].pPosition.x = parser.extractFloat();
+        vertex.pPosition.x = parser.extractFloat();
         parser.skipSpace();
-        outVert[inOutIndex].pPosition.y = parser.extractFloat();
+        vertex.pPosition.y = parser.extractFloat();
         parser.skipSpace();
-        outVert[inOutIndex].pPosition.z = parser.extractFloat();
+        vertex.pPosition.z = parser.extractFloat();
 
         parser.skipSpace();
-        outVert[inOutIndex].pNormal.x = parser.extractFloat();
+        vertex.pNormal.x = parser.extractFloat();
         parser.skipSpace();
-        outVert[inOutIndex].pNormal.y = parser.extractFloat();
+        vertex.pNormal.y = parser.extractFloat();
         parser.skipSpace();
-        outVert[inOutIndex].pNormal.z = parser.extractFloat();
+        vertex.pNormal.z = parser.extractFloat();
 
         parser.skipSpace();
-        outVert[inOutIndex].pTexture.x = parser.extractFloat();
+        vertex.pTexture.x = parser.extractFloat();
         parser.skipSpace();
-        outVert[inOutIndex].pTexture.y = parser.extractFloat();
+        vertex.pTexture.y = parser.extractFloat();
 
         ++inOutIndex;
         return true;
@@ -283,25 +320,151 @@ bool ObjReader::readVertex(ObjReadParser & parser, ObjMesh::VertexList & outVert
 }
 
 bool ObjReader::readIndexes(ObjReadParser & parser, ObjReaderListener::FaceIndexArray & outIndexes, ObjReaderListener::FaceIndex & inOUtIndex) {
+    // the extra indices are counted but not stored, the caller reports the incorrect count.
+    const auto store = [&](const std::int64_t value) {
+        if (inOUtIndex < outIndexes.size()) {
+            outIndexes[inOUtIndex] = static_cast<ObjReaderListener::FaceIndex>(value);
+        }
+        ++inOUtIndex;
+    };
     // IDX <n>
     if (parser.isMatch(MESH_IDX)) {
         parser.skipSpace();
-        outIndexes[inOUtIndex] = parser.extractInt();
-        ++inOUtIndex;
+        store(parser.extractInt64());
         return true;
     }
     // IDX10 <n> x 10
     if (parser.isMatch(MESH_IDX10)) {
         for (int n = 0; n < 10; ++n) {
             parser.skipSpace();
-            outIndexes[inOUtIndex] = parser.extractInt();
-            ++inOUtIndex;
+            store(parser.extractInt64());
         }
         return true;
     }
     return false;
 }
 
+/*!
+ * \details The geometry section is split into chunks by the line boundaries.
+ *          The first pass counts the vertices and the indices of each chunk,
+ *          so each chunk gets its offsets in the output arrays.
+ *          The second pass parses the chunks up to the one where the counts are reached.
+ *          The parser position is set to the same line where the sequential reading stops.
+ */
+void ObjReader::readGeometryParallel(ObjReadParser & parser, ObjMesh::VertexList & outVert,
+                                     ObjReaderListener::FaceIndexArray & outIndexes,
+                                     ObjReaderListener::Index & outVertCount,
+                                     ObjReaderListener::Index & outIndexCount) const {
+    struct Chunk {
+        const uint8_t * mBegin;
+        const uint8_t * mEnd;
+        ObjReaderListener::Index mVertices;
+        ObjReaderListener::Index mIndices;
+    };
+
+    if (outVert.empty() && outIndexes.empty()) {
+        return;
+    }
+    // the rest of the POINT_COUNTS line
+    parser.nextLine();
+    const uint8_t * begin = parser.position();
+    const uint8_t * end = parser.endPosition();
+    const std::size_t size = std::size_t(end - begin);
+    const std::size_t threads = actualThreadsCount(mWorkerThreads);
+    const std::size_t minChunkSize = 256 * 1024;
+    const std::size_t chunksCount = std::max(std::size_t(1), std::min(threads * 4, size / minChunkSize));
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunksCount);
+    const uint8_t * chunkBegin = begin;
+    for (std::size_t i = 1; i <= chunksCount && chunkBegin != end; ++i) {
+        const uint8_t * chunkEnd = end;
+        if (i != chunksCount) {
+            const uint8_t * from = std::max(chunkBegin, begin + size / chunksCount * i);
+            const void * eol = std::memchr(from, '\n', std::size_t(end - from));
+            chunkEnd = eol ? static_cast<const uint8_t *>(eol) + 1 : end;
+        }
+        chunks.push_back(Chunk{chunkBegin, chunkEnd, 0, 0});
+        chunkBegin = chunkEnd;
+    }
+
+    //-------------------------------------------------------------------------
+
+    parallelFor(chunks.size(), mWorkerThreads, [&](const std::size_t i) {
+        Chunk & chunk = chunks[i];
+        ObjReadParser chunkParser(chunk.mBegin, chunk.mEnd);
+        while (!chunkParser.isEnd()) {
+            if (chunkParser.isMatch(MESH_VT)) {
+                ++chunk.mVertices;
+            }
+            else if (chunkParser.isMatch(MESH_IDX)) {
+                ++chunk.mIndices;
+            }
+            else if (chunkParser.isMatch(MESH_IDX10)) {
+                chunk.mIndices += 10;
+            }
+            chunkParser.nextLine();
+        }
+    });
+
+    // The counts become the offsets.
+    std::size_t lastChunk = chunks.size();
+    ObjReaderListener::Index vertices = 0;
+    ObjReaderListener::Index indices = 0;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        const ObjReaderListener::Index chunkVertices = chunks[i].mVertices;
+        const ObjReaderListener::Index chunkIndices = chunks[i].mIndices;
+        chunks[i].mVertices = vertices;
+        chunks[i].mIndices = indices;
+        vertices += chunkVertices;
+        indices += chunkIndices;
+        if (lastChunk == chunks.size() && vertices >= outVert.size() && indices >= outIndexes.size()) {
+            lastChunk = i;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    if (lastChunk == chunks.size()) {
+        // The counts aren't reached, all the chunks are parsed and the caller reports it.
+        parallelFor(chunks.size(), mWorkerThreads, [&](const std::size_t i) {
+            ObjReadParser chunkParser(chunks[i].mBegin, chunks[i].mEnd);
+            ObjReaderListener::Index vertexIndex = chunks[i].mVertices;
+            ObjReaderListener::Index indexIndex = chunks[i].mIndices;
+            while (!chunkParser.isEnd()) {
+                if (!readVertex(chunkParser, outVert, vertexIndex)) {
+                    readIndexes(chunkParser, outIndexes, indexIndex);
+                }
+                chunkParser.nextLine();
+            }
+        });
+        outVertCount = vertices;
+        outIndexCount = indices;
+        parser.setPosition(end);
+        return;
+    }
+
+    const uint8_t * stopPosition = end;
+    parallelFor(lastChunk + 1, mWorkerThreads, [&](const std::size_t i) {
+        ObjReadParser chunkParser(chunks[i].mBegin, chunks[i].mEnd);
+        ObjReaderListener::Index vertexIndex = chunks[i].mVertices;
+        ObjReaderListener::Index indexIndex = chunks[i].mIndices;
+        while (!chunkParser.isEnd()) {
+            if (!readVertex(chunkParser, outVert, vertexIndex)) {
+                readIndexes(chunkParser, outIndexes, indexIndex);
+            }
+            if (i == lastChunk && vertexIndex >= outVert.size() && indexIndex >= outIndexes.size()) {
+                outVertCount = vertexIndex;
+                outIndexCount = indexIndex;
+                stopPosition = chunkParser.position();
+                return;
+            }
+            chunkParser.nextLine();
+        }
+    });
+    parser.setPosition(stopPosition);
+}
+
 bool ObjReader::readLod(ObjReadParser & parser) const {
     if (parser.isMatch(ATTR_LOD)) {
         parser.skipSpace();
@@ -1005,9 +1168,9 @@ bool ObjReader::readManipulators(ObjReadParser & parser) const {
 bool ObjReader::readTris(ObjReadParser & parser) const {
     if (parser.isMatch(MESH_TRIS)) {
         parser.skipSpace();
-        const ObjReaderListener::Index pos = parser.extractInt();
+        const auto pos = static_cast<ObjReaderListener::Index>(parser.extractInt64());
         parser.skipSpace();
-        const ObjReaderListener::Index count = parser.extractInt();
+        const auto count = static_cast<ObjReaderListener::Index>(parser.extractInt64());
         parser.skipSpace();
         mObjParserListener->gotTris(pos, count, parser.extractLineTilEol());
         return true;
@@ -52,7 +52,7 @@ public:
 
 private:
 
-    bool readFile(const std::string & filePath) const;
+    bool readFile(const Path & filePath) const;
 
     static bool readCounts(ObjReadParser & parser,
                            size_t & outVertices,
@@ -78,7 +78,14 @@ private:
 
     static bool readAnimLoop(ObjReadParser & parser, float & outVal);
 
+    void readGeometryParallel(ObjReadParser & parser, ObjMesh::VertexList & outVert,
+                              ObjReaderListener::FaceIndexArray & outIndexes,
+                              ObjReaderListener::Index & outVertCount,
+                              ObjReaderListener::Index & outIndexCount) const;
+
     ObjReaderListener * mObjParserListener = nullptr;
+    IOStatistic * mStatistic = nullptr;
+    std::size_t mWorkerThreads = 1;
 
 };
 
@@ -27,6 +27,10 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
 #include "sts/string/StringUtils.h"
 #include "ObjReaderInterpreter.h"
 #include "xpln/obj/ObjMain.h"
@@ -223,12 +227,17 @@ void ObjReaderInterpreter::gotLod(const float near, const float far, const std::
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
-void ObjReaderInterpreter::gotMeshVertices(const ObjMesh::VertexList & vertices) {
-    mVertices = vertices;
+void ObjReaderInterpreter::gotMeshVertices(ObjMesh::VertexList && vertices) {
+    if (mIsSharedMeshVertices) {
+        mSharedVertices = std::make_shared<const ObjMesh::VertexList>(std::move(vertices));
+    }
+    else {
+        mVertices = std::move(vertices);
+    }
 }
 
-void ObjReaderInterpreter::gotMeshFaces(const FaceIndexArray & indices) {
-    mIndices = indices;
+void ObjReaderInterpreter::gotMeshFaces(FaceIndexArray && indices) {
+    mIndices = std::move(indices);
 }
 
 /**************************************************************************************************/
@@ -468,7 +477,8 @@ void ObjReaderInterpreter::gotTris(const Index offset, const Index count, const
     checkForCreateLod();
     assert(mCurrentTransform);
 
-    if (offset + count > mIndices.size()) {
+    // it is written so because offset + count can overflow with the negative or huge values.
+    if (offset > mIndices.size() || count > mIndices.size() - offset) {
         throw std::runtime_error(ExcTxt("Incorrect Tris's parameters."));
     }
 
@@ -486,56 +496,50 @@ void ObjReaderInterpreter::gotTris(const Index offset, const Index count, const
 
     //--------------------------
 
+    // The ranges are checked above, so the arrays are accessed without the checks.
     ObjMesh::FaceList flist(count / 3);
-    size_t min = std::numeric_limits<size_t>::max();
-    size_t max = std::numeric_limits<size_t>::min();
-
-    // indices to faces and min/max vertex id
-    for (FaceIndex i = 0, idx = 0; i < count; i += 3) {
-        ObjMesh::Face & face = flist.at(idx++);
-
-        face.pV0 = mIndices.at(offset + i);
-        face.pV1 = mIndices.at(offset + i + 1);
-        face.pV2 = mIndices.at(offset + i + 2);
-
-        min = std::min(min, face.pV0);
-        min = std::min(min, face.pV1);
-        min = std::min(min, face.pV2);
-
-        max = std::max(max, face.pV0);
-        max = std::max(max, face.pV1);
-        max = std::max(max, face.pV2);
+    const FaceIndex * idx = mIndices.data() + offset;
+    FaceIndex min = idx[0];
+    FaceIndex max = idx[0];
+    for (auto & face : flist) {
+        face.pV0 = idx[0];
+        face.pV1 = idx[1];
+        face.pV2 = idx[2];
+        idx += 3;
+        min = std::min(min, std::min(face.pV0, std::min(face.pV1, face.pV2)));
+        max = std::max(max, std::max(face.pV0, std::max(face.pV1, face.pV2)));
     }
 
-    if (max > mVertices.size() - 1) {
+    const ObjMesh::VertexList & vertices = mSharedVertices ? *mSharedVertices : mVertices;
+    if (max >= vertices.size()) {
         throw std::runtime_error(ExcTxt("IDX value <").append(std::to_string(max))
                                  .append("> is out of range of the vertex array."));
     }
 
     //--------------------------
 
-    ObjMesh::VertexList vlist((max - min) + 1);
-
-    // make vertex array and fix vertex id of the faces
-    for (auto & face : flist) {
-        face.pV0 -= min;
-        face.pV1 -= min;
-        face.pV2 -= min;
-        /* can be optimized, there are identical idx values,
-         * so there are the situations when the same vertices are copied more than one time.
-         * example:
-         * IDX 2 1 0 2 3 1 2 0 3
-         */
-        vlist.at(face.pV0) = mVertices.at(face.pV0 + min);
-        vlist.at(face.pV1) = mVertices.at(face.pV1 + min);
-        vlist.at(face.pV2) = mVertices.at(face.pV2 + min);
+    // The vertices of one TRIS are usually a continuous range,
+    // so the mesh takes the whole range at once instead of the vertex by each face index.
+    auto * mesh = new ObjMesh;
+    const std::size_t rangeCount = static_cast<std::size_t>(max - min + 1);
+    if (mSharedVertices) {
+        mesh->setSharedVertices(mSharedVertices, static_cast<std::size_t>(min), rangeCount);
+    }
+    else {
+        const auto first = mVertices.begin() + static_cast<std::ptrdiff_t>(min);
+        mesh->pVertices.assign(first, first + static_cast<std::ptrdiff_t>(rangeCount));
+    }
+    if (min != 0) {
+        for (auto & face : flist) {
+            face.pV0 -= min;
+            face.pV1 -= min;
+            face.pV2 -= min;
+        }
     }
 
     //--------------------------
 
-    auto * mesh = new ObjMesh;
     mesh->pFaces.swap(flist);
-    mesh->pVertices.swap(vlist);
     mesh->setObjectName(extractComment(endLineComment, mesh->objectName().c_str()));
     mesh->pAttr = mCurrentAttrSet;
 
@@ -624,6 +628,10 @@ void ObjReaderInterpreter::gotRotateAnim(AnimRotate::KeyList & key, float ( & in
 /**************************************************************************************************/
 
 void ObjReaderInterpreter::gotFinished() {
+    // All the objects have taken their geometry.
+    ObjMesh::VertexList().swap(mVertices);
+    mSharedVertices.reset();
+    FaceIndexArray().swap(mIndices);
     ObjTransformation::correctImportTransform(*mObjMain, mRootMtx);
 }
 
@@ -633,6 +641,7 @@ void ObjReaderInterpreter::gotFinished() {
 
 void ObjReaderInterpreter::reset() {
     mVertices.clear();
+    mSharedVertices.reset();
     mIndices.clear();
     mCurrentLod = nullptr;
     mCurrentTransform = nullptr;
@@ -49,6 +49,12 @@ public:
     ObjReaderInterpreter(ObjMain * objMain, const TMatrix & rootMatrix, IOStatistic * ioStatistic);
     ~ObjReaderInterpreter();
 
+    /*!
+     * \details The meshes refer to the ranges of one shared vertices list instead of their own copies.
+     * \see \link ImportContext::setSharedMeshVertices \endlink
+     */
+    void setSharedMeshVertices(const bool state) { mIsSharedMeshVertices = state; }
+
 protected:
 
     //-----------------------------------------------------
@@ -82,8 +88,8 @@ protected:
 
     //-----------------------------------------------------
 
-    void gotMeshVertices(const ObjMesh::VertexList & vertices) override;
-    void gotMeshFaces(const FaceIndexArray & indices) override;
+    void gotMeshVertices(ObjMesh::VertexList && vertices) override;
+    void gotMeshFaces(FaceIndexArray && indices) override;
 
     //-----------------------------------------------------
 
@@ -144,7 +150,9 @@ private:
     Transform * mCurrentTransform;
 
     ObjMesh::VertexList mVertices;
+    ObjMesh::SharedVertexList mSharedVertices;
     FaceIndexArray mIndices;
+    bool mIsSharedMeshVertices = false;
 
     TMatrix mRootMtx;
 
@@ -123,8 +123,13 @@ public:
     //-----------------------------------------------------
     // Global Objects' data
 
-    virtual void gotMeshVertices(const ObjMesh::VertexList & vertices) = 0;
-    virtual void gotMeshFaces(const FaceIndexArray & indices) = 0;
+    /*!
+     * \details The arrays are moved to the listener, so the geometry isn't copied.
+     *          The objects take their parts by the \link ObjReaderListener::gotTris \endlink.
+     */
+    virtual void gotMeshVertices(ObjMesh::VertexList && vertices) = 0;
+    /*! \see \link ObjReaderListener::gotMeshVertices \endlink */
+    virtual void gotMeshFaces(FaceIndexArray && indices) = 0;
 
     //-----------------------------------------------------
     // Objects' data
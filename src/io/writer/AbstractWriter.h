@@ -80,22 +80,24 @@ public:
      * \details Dataref can be just an id and must be resolved to actual one.
      *          So you have to use this method for printing any datarefs into obj.
      * \param [in] dataref current dataref value.
-     * \return actual dataref value.
+     * \return actual dataref value, it is the specified one or the one from the loaded file,
+     *         so it is valid while the specified value and the writer are alive.
      * \exception std::domain_error is thrown if dataref must be resolved but there is no data to do it.
      *                              For example file with data for resolving isn't specified or isn't loaded.
      */
-    virtual std::string actualDataref(const std::string & dataref) = 0;
+    virtual const std::string & actualDataref(const std::string & dataref) = 0;
 
     /*!
      * \todo better description - needs link to this functional description 
      * \details Command can be just an id and must be resolved to actual one.
      *          So you have to use this method for printing any command into obj.
      * \param [in] command current command value.
-     * \return actual command value.
+     * \return actual command value, it is the specified one or the one from the loaded file,
+     *         so it is valid while the specified value and the writer are alive.
      * \exception std::domain_error is thrown if command must be resolved but there is no data to do it.
      *                              For example file with data for resolving isn't specified or isn't loaded.
      */
-    virtual std::string actualCommand(const std::string & command) = 0;
+    virtual const std::string & actualCommand(const std::string & command) = 0;
 
     /// @}
     //-------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <string>
+#include "AbstractWriter.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Collects lines into the string.
+ *          It is used for formatting a block of lines separately (for example by another thread)
+ *          and printing it into the main writer later.
+ * \details Datarefs and commands are resolved by the main writer.
+ */
+class BlockWriter : public AbstractWriter {
+public:
+
+    //-------------------------------------------------------------------------
+
+    explicit BlockWriter(AbstractWriter & mainWriter)
+        : mMainWriter(mainWriter) {}
+
+    BlockWriter(const BlockWriter &) = delete;
+    BlockWriter & operator =(const BlockWriter &) = delete;
+
+    virtual ~BlockWriter() = default;
+
+    //-------------------------------------------------------------------------
+
+    /*! \copydoc AbstractWriter::printLine */
+    void printLine(const char * msg) override {
+        if (msg) {
+            mBlock.append(space()).append(msg);
+        }
+        mBlock.push_back('\n');
+    }
+
+    /*! \copydoc AbstractWriter::actualDataref */
+    const std::string & actualDataref(const std::string & dataref) override {
+        return mMainWriter.actualDataref(dataref);
+    }
+
+    /*! \copydoc AbstractWriter::actualCommand */
+    const std::string & actualCommand(const std::string & command) override {
+        return mMainWriter.actualCommand(command);
+    }
+
+    //-------------------------------------------------------------------------
+
+    /*!
+     * \details Prints the collected lines into the main writer and clears the block.
+     */
+    void flushTo(AbstractWriter & writer) {
+        if (mBlock.empty()) {
+            return;
+        }
+        // the last EOL is printed by the main writer.
+        mBlock.pop_back();
+        writer.printLine(mBlock);
+        mBlock.clear();
+    }
+
+    std::string & block() { return mBlock; }
+
+    //-------------------------------------------------------------------------
+
+private:
+
+    AbstractWriter & mMainWriter;
+    std::string mBlock;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -0,0 +1,659 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "ExportPlan.h"
+#include "AbstractWriter.h"
+#include "algorithms/VertexCacheAlg.h"
+#include "xpln/obj/ObjMain.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLine.h"
+#include "xpln/obj/ObjLightPoint.h"
+
+namespace xobj {
+
+const std::size_t ExportPlan::npos;
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Static area *///////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Bits of the vertex values. The vertices are welded only if they are printed identically,
+ *          so the values are compared exactly, only the negative zero is the same as the positive one.
+ */
+class WeldedVertexKey {
+public:
+
+    explicit WeldedVertexKey(const MeshVertex & v) {
+        const float values[] = {
+            v.pPosition.x, v.pPosition.y, v.pPosition.z,
+            v.pNormal.x, v.pNormal.y, v.pNormal.z,
+            v.pTexture.x, v.pTexture.y
+        };
+        for (std::size_t i = 0; i < 8; ++i) {
+            const float val = values[i] == 0.0f ? 0.0f : values[i];
+            std::memcpy(&mBits[i], &val, sizeof(float));
+        }
+    }
+
+    bool operator==(const WeldedVertexKey & other) const {
+        return std::memcmp(mBits, other.mBits, sizeof(mBits)) == 0;
+    }
+
+    struct Hash {
+        std::size_t operator()(const WeldedVertexKey & key) const {
+            // FNV-1a by the 32-bit words
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (const std::uint32_t bits : key.mBits) {
+                hash ^= bits;
+                hash *= 1099511628211ULL;
+            }
+            return std::size_t(hash ^ (hash >> 32));
+        }
+    };
+
+private:
+
+    std::uint32_t mBits[8];
+
+};
+
+/*!
+ * \details Hash of the attributes set values which are compared exactly.
+ *          The float values are compared with the tolerance, so they aren't hashed
+ *          and the sets with the same hash must be compared anyway.
+ *          The manipulator's datarefs and commands are taken by printing it without the output.
+ */
+class AttrStateHash : public AbstractWriter {
+public:
+
+    std::uint64_t operator()(const AttrSet & attr) {
+        mHash = 14695981039346656037ULL;
+        add(attr.isDraw());
+        add(attr.isDraped());
+        add(attr.isTree());
+        add(attr.isTwoSided());
+        add(attr.isCastShadow());
+        add(attr.isSolidForCamera());
+        add(bool(attr.polyOffset()));
+        add(bool(attr.hard()));
+        add(bool(attr.shiny()));
+        add(bool(attr.blend()));
+        add(bool(attr.cockpit()));
+        add(bool(attr.lightLevel()));
+        add(attr.lightLevel().dataref());
+        const AttrManipBase * manip = attr.manipulator();
+        add(manip != nullptr);
+        if (manip) {
+            add(std::uint64_t(manip->type().id()));
+            add(std::uint64_t(manip->cursor().id()));
+            manip->printObj(*this);
+        }
+        return mHash;
+    }
+
+    void printLine(const char *) override {}
+
+    const std::string & actualDataref(const std::string & dataref) override {
+        add(dataref);
+        return dataref;
+    }
+
+    const std::string & actualCommand(const std::string & command) override {
+        add(command);
+        return command;
+    }
+
+private:
+
+    void add(const std::uint64_t value) {
+        // FNV-1a
+        mHash ^= value;
+        mHash *= 1099511628211ULL;
+    }
+
+    void add(const std::string & value) {
+        add(std::uint64_t(std::hash<std::string>()(value)));
+    }
+
+    std::uint64_t mHash = 0;
+
+};
+
+inline std::uint64_t indicesHash(const std::size_t * indices, const std::size_t count) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        hash ^= indices[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline bool isMeshRecord(const ExportPlan::Record & record) {
+    return record.mType == ExportPlan::RECORD_OBJECT && record.mObject->objType() == OBJ_MESH;
+}
+
+inline MeshVertex tableVertex(const MeshVertex & vertex, const bool isTree) {
+    MeshVertex res = vertex;
+    if (isTree) {
+        // it is how the tree vertices are printed.
+        res.pNormal = Point3(0.0f, 1.0f, 0.0f);
+    }
+    return res;
+}
+
+inline bool isBlended(const AttrSet & attr) {
+    // ATTR_no_blend and ATTR_shadow_blend use the alpha test, so their drawing order isn't important.
+    return !attr.blend() || attr.blend().type() == AttrBlend::blend;
+}
+
+inline bool isSamePosition(const Point3 & p1, const Point3 & p2) {
+    return p1.x == p2.x && p1.y == p2.y && p1.z == p2.z;
+}
+
+inline bool isDegenerate(const MeshVertex * vertices, const MeshFace & f) {
+    return isSamePosition(vertices[f.pV0].pPosition, vertices[f.pV1].pPosition) ||
+           isSamePosition(vertices[f.pV1].pPosition, vertices[f.pV2].pPosition) ||
+           isSamePosition(vertices[f.pV2].pPosition, vertices[f.pV0].pPosition);
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+void ExportPlan::clear() {
+    mRecords.clear();
+    mMeshes.clear();
+    mLines.clear();
+    mLightPoints.clear();
+    mAttrStates.clear();
+    mAttrStateBuckets.clear();
+    mVertices.clear();
+    mIndices.clear();
+    mLodMeshesCount = 0;
+    mMeshVerticesCount = 0;
+    mMeshFacesCount = 0;
+    mLineVerticesCount = 0;
+    mHasMeshTable = false;
+    mWeldedVerticesCount = 0;
+    mUnusedVerticesCount = 0;
+    mDegenerateFacesCount = 0;
+    mRemovedMeshesCount = 0;
+    mSharedFacesCount = 0;
+    mCacheMissesBefore = 0;
+    mCacheMissesAfter = 0;
+}
+
+void ExportPlan::build(const ObjMain & main) {
+    clear();
+    for (const auto & lod : main.lods()) {
+        mRecords.emplace_back(Record{RECORD_LOD, lod.get(), &lod->transform(), nullptr, 0, 0, npos});
+        flatten(lod->transform(), nullptr);
+        addRecord(RECORD_SECTION_END, nullptr);
+    }
+    mLodMeshesCount = mMeshes.size();
+
+    flatten(main.pDraped.transform(), nullptr);
+    addRecord(RECORD_SECTION_END, nullptr);
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+void ExportPlan::optimizeMeshes(const bool shareRanges) {
+    const std::size_t sourceVerticesCount = mMeshVerticesCount;
+    mVertices.clear();
+    mIndices.clear();
+    mVertices.reserve(sourceVerticesCount);
+    mIndices.reserve(mMeshFacesCount * 3);
+    mWeldedVerticesCount = 0;
+    mDegenerateFacesCount = 0;
+    mRemovedMeshesCount = 0;
+    mSharedFacesCount = 0;
+
+    std::unordered_map<WeldedVertexKey, std::size_t, WeldedVertexKey::Hash> welded;
+    welded.reserve(sourceVerticesCount);
+    // faces offset of the printed ranges by the hash of their indices.
+    std::unordered_multimap<std::uint64_t, std::size_t> ranges;
+    // global index of each mesh vertex, npos for the unused ones.
+    std::vector<std::size_t> globalIndices;
+
+    for (auto & record : mRecords) {
+        if (!isMeshRecord(record)) {
+            continue;
+        }
+        const auto * mobj = static_cast<const ObjMesh*>(record.mObject);
+        const bool isTree = mobj->pAttr.isTree();
+        const std::size_t facesOffset = mIndices.size() / 3;
+
+        // The vertices are added in their order, so the mesh without
+        // duplicates, unused vertices and degenerate faces is printed as it is.
+        const MeshVertex * vertices = mobj->vertices();
+        const std::size_t verticesCount = mobj->verticesCount();
+        globalIndices.assign(verticesCount, npos);
+        for (const MeshFace & f : mobj->pFaces) {
+            assert(f.pV0 < verticesCount && f.pV1 < verticesCount && f.pV2 < verticesCount);
+            if (!isDegenerate(vertices, f)) {
+                globalIndices[f.pV0] = globalIndices[f.pV1] = globalIndices[f.pV2] = 0;
+            }
+        }
+
+        for (std::size_t i = 0; i < globalIndices.size(); ++i) {
+            if (globalIndices[i] == npos) {
+                continue;
+            }
+            const MeshVertex vertex = tableVertex(vertices[i], isTree);
+            const auto result = welded.emplace(WeldedVertexKey(vertex), mVertices.size());
+            if (result.second) {
+                mVertices.emplace_back(vertex);
+            }
+            else {
+                ++mWeldedVerticesCount;
+            }
+            globalIndices[i] = result.first->second;
+        }
+
+        for (const MeshFace & f : mobj->pFaces) {
+            if (isDegenerate(vertices, f)) {
+                ++mDegenerateFacesCount;
+                continue;
+            }
+            mIndices.emplace_back(globalIndices[f.pV0]);
+            mIndices.emplace_back(globalIndices[f.pV1]);
+            mIndices.emplace_back(globalIndices[f.pV2]);
+        }
+
+        record.mOffset = facesOffset;
+        record.mCount = mIndices.size() / 3 - facesOffset;
+        if (!shareRanges || record.mCount == 0) {
+            continue;
+        }
+
+        // The identical meshes (e.g. the same geometry in several LODs) have the same welded indices,
+        // so the range which is already in the IDX section is reused.
+        const std::size_t * indices = mIndices.data() + facesOffset * 3;
+        const std::size_t count = record.mCount * 3;
+        const std::uint64_t hash = indicesHash(indices, count);
+        const auto candidates = ranges.equal_range(hash);
+        const auto shared = std::find_if(candidates.first, candidates.second, [&](const auto & range) {
+            const std::size_t * rangeIndices = mIndices.data() + range.second * 3;
+            return std::equal(indices, indices + count, rangeIndices);
+        });
+        if (shared != candidates.second) {
+            mIndices.resize(facesOffset * 3);
+            record.mOffset = shared->second;
+            mSharedFacesCount += record.mCount;
+        }
+        else {
+            ranges.emplace(hash, facesOffset);
+        }
+    }
+
+    // All the faces of such meshes are degenerate, they would be printed as "TRIS <offset> 0"
+    // which isn't a valid command, so the meshes are removed with their attributes.
+    const auto removed = std::remove_if(mRecords.begin(), mRecords.end(), [](const Record & record) {
+        return isMeshRecord(record) && record.mCount == 0;
+    });
+    mRemovedMeshesCount = std::size_t(mRecords.end() - removed);
+    mRecords.erase(removed, mRecords.end());
+
+    mUnusedVerticesCount = sourceVerticesCount - mVertices.size() - mWeldedVerticesCount;
+    mMeshVerticesCount = mVertices.size();
+    mMeshFacesCount = mIndices.size() / 3;
+    mHasMeshTable = true;
+}
+
+void ExportPlan::makeMeshTable() {
+    mVertices.clear();
+    mIndices.clear();
+    mVertices.reserve(mMeshVerticesCount);
+    mIndices.reserve(mMeshFacesCount * 3);
+    for (const auto * mobj : mMeshes) {
+        const std::size_t offset = mVertices.size();
+        const bool isTree = mobj->pAttr.isTree();
+        const MeshVertex * vertices = mobj->vertices();
+        for (std::size_t i = 0; i < mobj->verticesCount(); ++i) {
+            mVertices.emplace_back(tableVertex(vertices[i], isTree));
+        }
+        for (const MeshFace & f : mobj->pFaces) {
+            mIndices.emplace_back(f.pV0 + offset);
+            mIndices.emplace_back(f.pV1 + offset);
+            mIndices.emplace_back(f.pV2 + offset);
+        }
+    }
+    mHasMeshTable = true;
+}
+
+//-------------------------------------------------------------------------
+
+void ExportPlan::tableMarks(std::vector<TableMark> & outMarks) const {
+    outMarks.clear();
+    if (!mHasMeshTable) {
+        return;
+    }
+    // The records may be reordered by the attributes, so the ranges are taken by their offsets.
+    std::vector<const Record*> ranges;
+    for (const auto & record : mRecords) {
+        if (isMeshRecord(record) && record.mCount != 0) {
+            ranges.emplace_back(&record);
+        }
+    }
+    std::stable_sort(ranges.begin(), ranges.end(), [](const Record * r1, const Record * r2) {
+        return r1->mOffset < r2->mOffset;
+    });
+
+    std::size_t next = 0;
+    for (const Record * record : ranges) {
+        const std::size_t * indices = mIndices.data() + record->mOffset * 3;
+        const std::size_t max = *std::max_element(indices, indices + record->mCount * 3);
+        if (max >= next) {
+            outMarks.emplace_back(TableMark{next, static_cast<const ObjMesh*>(record->mObject)});
+            next = max + 1;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void ExportPlan::optimizeVertexCache() {
+    if (!mHasMeshTable) {
+        makeMeshTable();
+    }
+    const std::size_t verticesCount = mVertices.size();
+    mCacheMissesBefore = VertexCacheAlg::cacheMisses(mIndices.data(), mIndices.size(), verticesCount);
+
+    //-------------------------------------------------------------------------
+    // The meshes are optimized with their local vertex indices
+    // for the algorithm memory to depend on the mesh size only.
+
+    std::vector<std::size_t> localIndices(verticesCount, npos);
+    std::vector<std::size_t> globalIndices;
+    // the ranges shared by the identical meshes are optimized once.
+    std::vector<bool> optimizedRanges(mSharedFacesCount != 0 ? mIndices.size() / 3 : 0, false);
+    for (const auto & record : mRecords) {
+        if (!isMeshRecord(record) || record.mCount == 0) {
+            continue;
+        }
+        if (mSharedFacesCount != 0) {
+            if (optimizedRanges[record.mOffset]) {
+                continue;
+            }
+            optimizedRanges[record.mOffset] = true;
+        }
+        std::size_t * indices = mIndices.data() + record.mOffset * 3;
+        const std::size_t count = record.mCount * 3;
+        globalIndices.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t & local = localIndices[indices[i]];
+            if (local == npos) {
+                local = globalIndices.size();
+                globalIndices.emplace_back(indices[i]);
+            }
+            indices[i] = local;
+        }
+
+        VertexCacheAlg::optimize(indices, count, globalIndices.size());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            indices[i] = globalIndices[indices[i]];
+        }
+        for (const std::size_t global : globalIndices) {
+            localIndices[global] = npos;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // vertices in the first use order for the fetch locality.
+
+    std::vector<std::size_t> & newIndices = localIndices;
+    std::vector<MeshVertex> vertices;
+    vertices.reserve(verticesCount);
+    for (auto & index : mIndices) {
+        std::size_t & newIndex = newIndices[index];
+        if (newIndex == npos) {
+            newIndex = vertices.size();
+            vertices.emplace_back(mVertices[index]);
+        }
+        index = newIndex;
+    }
+    for (std::size_t i = 0; i < verticesCount; ++i) {
+        if (newIndices[i] == npos) {
+            vertices.emplace_back(mVertices[i]);
+        }
+    }
+    mVertices.swap(vertices);
+
+    mCacheMissesAfter = VertexCacheAlg::cacheMisses(mIndices.data(), mIndices.size(), verticesCount);
+}
+
+void ExportPlan::reorderByAttributes() {
+    // the meshes which can be moved inside the run of their transform's objects.
+    // The run has the same owner and is between the animation records,
+    // so the meshes are moved only inside one ANIM_begin/ANIM_end level.
+    const auto isMovable = [](const Record & record) {
+        return isMeshRecord(record) &&
+               record.mObject->dataBefore().empty() &&
+               record.mObject->dataAfter().empty();
+    };
+
+    struct SortKey {
+        std::size_t mGroup;
+        std::size_t mPosition;
+        bool mBlended;
+        bool operator<(const SortKey & other) const {
+            if (mBlended != other.mBlended) {
+                return other.mBlended;
+            }
+            return mGroup < other.mGroup;
+        }
+    };
+
+    std::vector<std::size_t> groupPositions(mAttrStates.size(), npos);
+    std::vector<SortKey> keys;
+    std::vector<Record> sorted;
+
+    std::size_t begin = 0;
+    while (begin < mRecords.size()) {
+        if (!isMovable(mRecords[begin])) {
+            ++begin;
+            continue;
+        }
+        std::size_t end = begin + 1;
+        while (end < mRecords.size() && isMovable(mRecords[end]) &&
+               mRecords[end].mTransform == mRecords[begin].mTransform) {
+            ++end;
+        }
+
+        // The meshes with the same attributes are grouped at the place of the first one.
+        // The blended meshes are moved after the other ones and keep their order
+        // because the drawing order is important for the translucent geometry.
+        keys.clear();
+        for (std::size_t i = begin; i < end; ++i) {
+            const Record & record = mRecords[i];
+            const bool blended = isBlended(static_cast<const ObjMesh*>(record.mObject)->pAttr);
+            std::size_t & group = groupPositions[record.mAttrState];
+            if (group == npos) {
+                group = i;
+            }
+            keys.emplace_back(SortKey{blended ? i : group, i, blended});
+        }
+        std::stable_sort(keys.begin(), keys.end());
+
+        sorted.clear();
+        for (const auto & key : keys) {
+            sorted.emplace_back(mRecords[key.mPosition]);
+            groupPositions[mRecords[key.mPosition].mAttrState] = npos;
+        }
+        std::copy(sorted.begin(), sorted.end(), mRecords.begin() + std::ptrdiff_t(begin));
+        begin = end;
+    }
+}
+
+std::size_t ExportPlan::removeEmptyAnimations() {
+    // The records are compacted in place, the stack keeps
+    // the output positions of the opened animations.
+    std::vector<std::size_t> opened;
+    std::size_t out = 0;
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i < mRecords.size(); ++i) {
+        const Record & record = mRecords[i];
+        if (record.mType == RECORD_ANIM_BEGIN) {
+            opened.emplace_back(out);
+        }
+        else if (record.mType == RECORD_ANIM_END) {
+            const std::size_t begin = opened.back();
+            opened.pop_back();
+            if (begin + 1 == out) {
+                out = begin;
+                ++removed;
+                continue;
+            }
+        }
+        mRecords[out++] = record;
+    }
+    mRecords.resize(out);
+    return removed;
+}
+
+std::size_t ExportPlan::rangeRecordsCount(const std::size_t index) const {
+    const Record & first = mRecords[index];
+    const auto isRange = [](const Record & record) {
+        if (record.mType != RECORD_OBJECT) {
+            return false;
+        }
+        const eObjectType type = record.mObject->objType();
+        return (type == OBJ_MESH || type == OBJ_LIGHT_POINT) &&
+               record.mObject->dataBefore().empty() &&
+               record.mObject->dataAfter().empty();
+    };
+    if (!isRange(first)) {
+        return 1;
+    }
+
+    const eObjectType type = first.mObject->objType();
+    std::size_t offset = first.mOffset + first.mCount;
+    std::size_t end = index + 1;
+    for (; end < mRecords.size(); ++end) {
+        const Record & record = mRecords[end];
+        if (!isRange(record) || record.mObject->objType() != type ||
+            record.mAttrState != first.mAttrState || record.mOffset != offset) {
+            break;
+        }
+        offset += record.mCount;
+    }
+    return end - index;
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
+void ExportPlan::flatten(const Transform & transform, const Transform * owner) {
+    const bool hasAnim = transform.hasAnim();
+    if (hasAnim) {
+        addRecord(RECORD_ANIM_BEGIN, &transform);
+    }
+    // The not animated transforms are collapsed into the nearest animated parent or the root.
+    if (hasAnim || owner == nullptr) {
+        owner = &transform;
+    }
+
+    for (const auto & objBase : transform.objList()) {
+        const ObjAbstract * obj = objBase.get();
+        addRecord(RECORD_OBJECT, owner, obj);
+        Record & record = mRecords.back();
+        switch (obj->objType()) {
+            case OBJ_MESH: {
+                const auto * mobj = static_cast<const ObjMesh*>(obj);
+                record.mOffset = mMeshFacesCount;
+                record.mCount = mobj->pFaces.size();
+                record.mAttrState = attrStateIndex(mobj->pAttr);
+                mMeshes.emplace_back(mobj);
+                mMeshVerticesCount += mobj->verticesCount();
+                mMeshFacesCount += mobj->pFaces.size();
+                break;
+            }
+            case OBJ_LINE: {
+                const auto * lobj = static_cast<const ObjLine*>(obj);
+                record.mOffset = mLineVerticesCount;
+                record.mCount = lobj->verticesList().size();
+                mLines.emplace_back(lobj);
+                mLineVerticesCount += lobj->verticesList().size();
+                break;
+            }
+            case OBJ_LIGHT_POINT: {
+                record.mOffset = mLightPoints.size();
+                record.mCount = 1;
+                mLightPoints.emplace_back(static_cast<const ObjLightPoint*>(obj));
+                break;
+            }
+            default: break;
+        }
+    }
+
+    for (Transform::TransformIndex i = 0; i < transform.childrenNum(); ++i) {
+        flatten(*transform.childAt(i), owner);
+    }
+
+    if (hasAnim) {
+        addRecord(RECORD_ANIM_END, &transform);
+    }
+}
+
+void ExportPlan::addRecord(const eRecordType type, const Transform * transform, const ObjAbstract * obj) {
+    mRecords.emplace_back(Record{type, nullptr, transform, obj, 0, 0, npos});
+}
+
+std::size_t ExportPlan::attrStateIndex(const AttrSet & attr) {
+    // Only the states with the same hash are compared, so the cockpit objects
+    // with a lot of the unique manipulators don't make the building quadratic.
+    // The search starts from the last added state because the neighbour meshes usually have the same one.
+    // AttrSet doesn't compare the manipulator when it has not own one, so both ways are checked.
+    std::vector<std::size_t> & bucket = mAttrStateBuckets[AttrStateHash()(attr)];
+    for (auto it = bucket.rbegin(); it != bucket.rend(); ++it) {
+        if (*mAttrStates[*it] == attr && attr == *mAttrStates[*it]) {
+            return *it;
+        }
+    }
+    bucket.emplace_back(mAttrStates.size());
+    mAttrStates.emplace_back(&attr);
+    return mAttrStates.size() - 1;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include "xpln/Export.h"
+#include "xpln/obj/MeshVertex.h"
+
+namespace xobj {
+
+class ObjMain;
+class ObjLodGroup;
+class ObjAbstract;
+class ObjMesh;
+class ObjLine;
+class ObjLightPoint;
+class AttrSet;
+class Transform;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details The prepared object flattened into arrays by one traversal of the transforms tree.
+ *          The writers iterate the arrays linearly instead of walking the tree,
+ *          the records are in the printing order of the objects section
+ *          and the geometry arrays are in the printing order of the VT, VLINE and VLIGHT sections.
+ * \note The plan keeps pointers to the object's data so it must not be used after the object is changed.
+ */
+class ExportPlan {
+public:
+
+    //-------------------------------------------------------------------------
+
+    enum eRecordType : std::uint8_t {
+        RECORD_LOD, //!< Beginning of the LOD, see Record::mLod.
+        RECORD_ANIM_BEGIN, //!< Beginning of the animated transform, see Record::mTransform.
+        RECORD_OBJECT, //!< The object, see Record::mObject and Record::mTransform.
+        RECORD_ANIM_END, //!< End of the animated transform, see Record::mTransform.
+        RECORD_SECTION_END, //!< End of the LOD or the draped geometry.
+    };
+
+    struct Record {
+        eRecordType mType;
+        const ObjLodGroup * mLod;
+        /*!
+         * \details For the objects it is the nearest animated transform (the object's one or its parent)
+         *          or the root, i.e. the not animated transforms are collapsed because
+         *          they are already baked into the objects' coordinates by the export transformation.
+         */
+        const Transform * mTransform;
+        const ObjAbstract * mObject;
+        /*!
+         * \details Faces offset for meshes, vertices offset for lines
+         *          and index for light points, otherwise 0.
+         */
+        std::size_t mOffset;
+        /*!
+         * \details Faces count for meshes, vertices count for lines
+         *          and 1 for light points, otherwise 0.
+         */
+        std::size_t mCount;
+        /*!
+         * \details Index in the attrStates() for meshes, otherwise npos.
+         */
+        std::size_t mAttrState;
+    };
+
+    static const std::size_t npos = std::size_t(-1);
+
+    /*!
+     * \details The first vertex of the mesh in the global VT table, see tableMarks().
+     */
+    struct TableMark {
+        std::size_t mVertex;
+        const ObjMesh * mMesh;
+    };
+
+    //-------------------------------------------------------------------------
+
+    ExportPlan() = default;
+    ExportPlan(const ExportPlan &) = delete;
+    ExportPlan & operator=(const ExportPlan &) = delete;
+    ~ExportPlan() = default;
+
+    //-------------------------------------------------------------------------
+
+    /*!
+     * \details Flattens the LODs and the draped geometry of the object.
+     *          The previous data is cleared but the memory is reused.
+     */
+    XpObjLib void build(const ObjMain & main);
+    XpObjLib void clear();
+
+    /*!
+     * \details Makes the global VT table of all the meshes (including the draped ones)
+     *          where the identical vertices are welded, the vertices unused by any face are dropped
+     *          and the degenerate faces (two corners at the same position) are removed.
+     *          The faces offsets and counts of the mesh records are updated,
+     *          the records of the meshes whose faces are all degenerate are removed (see removedMeshesCount()),
+     *          their faces are counted in degenerateFacesCount().
+     * \param [in] shareRanges the identical meshes use one range of the IDX section, see sharedFacesCount().
+     */
+    XpObjLib void optimizeMeshes(bool shareRanges = false);
+
+    /*!
+     * \details Reorders the faces of each mesh for the GPU vertex cache locality (see VertexCacheAlg)
+     *          and renumbers the global VT table in the first use order.
+     *          The faces stay in the ranges of their meshes.
+     *          The global VT table is made without welding if optimizeMeshes wasn't called.
+     */
+    XpObjLib void optimizeVertexCache();
+
+    /*!
+     * \details Reorders the meshes to minimize the attributes changes.
+     *          The meshes are moved only among the consecutive meshes with the same owner
+     *          (the nearest animated transform or the root, see Record::mTransform),
+     *          so the not animated meshes inside an animation are reordered too,
+     *          but nothing is moved across the ANIM_begin/ANIM_end records.
+     *          The meshes with the same attributes (including the manipulator) are grouped
+     *          at the place of the first one. The blended meshes keep their order and are moved
+     *          after the alpha tested ones (ATTR_no_blend, ATTR_shadow_blend) because the drawing order
+     *          of the translucent geometry is important.
+     *          Other objects and the meshes with the custom data lines aren't moved and split the groups.
+     * \note Only the records are reordered, the geometry offsets are not changed.
+     */
+    XpObjLib void reorderByAttributes();
+
+    /*!
+     * \details Count of the consecutive records starting at the index which can be printed
+     *          by one TRIS or LIGHTS command: the meshes with the same attributes state or the light points
+     *          with the contiguous geometry ranges and without the custom data lines.
+     * \return 1 if the record can't be merged with the next ones.
+     */
+    XpObjLib std::size_t rangeRecordsCount(std::size_t index) const;
+
+    /*!
+     * \details Removes the animations which don't contain any object
+     *          (including their nested animations without objects).
+     * \return Count of the removed animations.
+     */
+    XpObjLib std::size_t removeEmptyAnimations();
+
+    //-------------------------------------------------------------------------
+
+    const std::vector<Record> & records() const { return mRecords; }
+
+    /*!
+     * \details Meshes of the LODs followed by the draped meshes, see lodMeshesCount().
+     */
+    const std::vector<const ObjMesh*> & meshes() const { return mMeshes; }
+    const std::vector<const ObjLine*> & lines() const { return mLines; }
+    const std::vector<const ObjLightPoint*> & lightPoints() const { return mLightPoints; }
+
+    /*!
+     * \details Global VT table and IDX section, they are used only if hasMeshTable() is true.
+     * \note Normals of the tree meshes are already replaced with the vertical ones.
+     */
+    bool hasMeshTable() const { return mHasMeshTable; }
+    const std::vector<MeshVertex> & vertices() const { return mVertices; }
+    const std::vector<std::size_t> & indices() const { return mIndices; }
+
+    /*!
+     * \details Positions of the meshes in the global VT table for the debug marks.
+     *          The table vertices are in the order of the meshes ranges in the IDX section,
+     *          so the vertices which each mesh adds to the table are a continuous block.
+     *          The meshes which don't add any vertex (e.g. the identical ones) haven't the mark.
+     * \param [out] outMarks sorted by the vertex.
+     */
+    XpObjLib void tableMarks(std::vector<TableMark> & outMarks) const;
+
+    std::size_t weldedVerticesCount() const { return mWeldedVerticesCount; }
+    std::size_t unusedVerticesCount() const { return mUnusedVerticesCount; }
+    std::size_t degenerateFacesCount() const { return mDegenerateFacesCount; }
+    std::size_t removedMeshesCount() const { return mRemovedMeshesCount; }
+    std::size_t sharedFacesCount() const { return mSharedFacesCount; }
+
+    /*!
+     * \details Vertex cache misses of the IDX section before and after optimizeVertexCache.
+     * \see VertexCacheAlg::cacheMisses
+     */
+    std::size_t cacheMissesBefore() const { return mCacheMissesBefore; }
+    std::size_t cacheMissesAfter() const { return mCacheMissesAfter; }
+
+    /*!
+     * \details Unique attributes sets of the meshes.
+     */
+    const std::vector<const AttrSet*> & attrStates() const { return mAttrStates; }
+
+    std::size_t lodMeshesCount() const { return mLodMeshesCount; }
+    std::size_t meshVerticesCount() const { return mMeshVerticesCount; }
+    std::size_t meshFacesCount() const { return mMeshFacesCount; }
+    std::size_t lineVerticesCount() const { return mLineVerticesCount; }
+
+    //-------------------------------------------------------------------------
+
+private:
+
+    void flatten(const Transform & transform, const Transform * owner);
+    void addRecord(eRecordType type, const Transform * transform, const ObjAbstract * obj = nullptr);
+    std::size_t attrStateIndex(const AttrSet & attr);
+    void makeMeshTable();
+
+    std::vector<Record> mRecords;
+    std::vector<const ObjMesh*> mMeshes;
+    std::vector<const ObjLine*> mLines;
+    std::vector<const ObjLightPoint*> mLightPoints;
+    std::vector<const AttrSet*> mAttrStates;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> mAttrStateBuckets;
+    std::vector<MeshVertex> mVertices;
+    std::vector<std::size_t> mIndices;
+
+    std::size_t mLodMeshesCount = 0;
+    std::size_t mMeshVerticesCount = 0;
+    std::size_t mMeshFacesCount = 0;
+    std::size_t mLineVerticesCount = 0;
+
+    bool mHasMeshTable = false;
+    std::size_t mWeldedVerticesCount = 0;
+    std::size_t mUnusedVerticesCount = 0;
+    std::size_t mDegenerateFacesCount = 0;
+    std::size_t mRemovedMeshesCount = 0;
+    std::size_t mSharedFacesCount = 0;
+    std::size_t mCacheMissesBefore = 0;
+    std::size_t mCacheMissesAfter = 0;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
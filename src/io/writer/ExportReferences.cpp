@@ -0,0 +1,206 @@
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include "ExportReferences.h"
+#include <algorithm>
+#include "AbstractWriter.h"
+#include "ExportPlan.h"
+#include "ObjWriteAnim.h"
+#include "common/Logger.h"
+#include "xpln/obj/ObjMesh.h"
+#include "xpln/obj/ObjLightCustom.h"
+#include "xpln/obj/ObjLightSpillCust.h"
+#include "xpln/obj/Transform.h"
+#include "xpln/obj/manipulators/AttrManipBase.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Records the values instead of resolving them.
+ *          It is used for the manipulators which know their datarefs and commands only while printing.
+ */
+class ReferencesCollector : public AbstractWriter {
+public:
+
+    ReferencesCollector(std::unordered_set<std::string> & datarefs, std::unordered_set<std::string> & commands)
+        : mDatarefs(datarefs),
+          mCommands(commands) {}
+
+    void printLine(const char *) override {}
+
+    const std::string & actualDataref(const std::string & dataref) override {
+        if (!dataref.empty()) {
+            mDatarefs.emplace(dataref);
+        }
+        return dataref;
+    }
+
+    const std::string & actualCommand(const std::string & command) override {
+        if (!command.empty()) {
+            mCommands.emplace(command);
+        }
+        return command;
+    }
+
+private:
+
+    std::unordered_set<std::string> & mDatarefs;
+    std::unordered_set<std::string> & mCommands;
+
+};
+
+/*!
+ * \details Resolves the ids of the values.
+ * \param [in, out] values
+ * \param [in] find returns the actual value pointer or nullptr.
+ * \param [out] outMissing
+ */
+template<typename Find>
+void resolveIds(std::unordered_set<std::string> & values, Find find, std::vector<std::string> & outMissing) {
+    std::unordered_set<std::string> resolved;
+    resolved.reserve(values.size());
+    for (const auto & val : values) {
+        if (!Dataref::isKeyId(val)) {
+            resolved.emplace(val);
+            continue;
+        }
+        const std::string * actual = find(Dataref::keyToId(val));
+        if (actual) {
+            resolved.emplace(*actual);
+        }
+        else {
+            outMissing.emplace_back(val);
+        }
+    }
+    values.swap(resolved);
+}
+
+inline std::string joinSorted(std::vector<std::string> & values) {
+    std::sort(values.begin(), values.end());
+    std::string out;
+    for (const auto & val : values) {
+        if (!out.empty()) {
+            out.append(", ");
+        }
+        out.append(val);
+    }
+    return out;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+void ExportReferences::collect(const ExportPlan & plan, const ObjWriteAnim & animWriter) {
+    clear();
+    ReferencesCollector collector(mDatarefs, mCommands);
+    for (const ExportPlan::Record & record : plan.records()) {
+        if (record.mType == ExportPlan::RECORD_ANIM_BEGIN) {
+            const Transform & tr = *record.mTransform;
+            for (const auto & anim : tr.pAnimTrans) {
+                if (animWriter.isPrinted(anim)) {
+                    collector.actualDataref(anim.pDrf);
+                }
+            }
+            for (const auto & anim : tr.pAnimRotate) {
+                if (animWriter.isPrinted(anim)) {
+                    collector.actualDataref(anim.pDrf);
+                }
+            }
+            for (const auto & key : tr.pAnimVis.pKeys) {
+                collector.actualDataref(key.pDrf);
+            }
+        }
+        else if (record.mType == ExportPlan::RECORD_OBJECT) {
+            const ObjAbstract & obj = *record.mObject;
+            switch (obj.objType()) {
+                case OBJ_MESH: {
+                    const AttrSet & attr = static_cast<const ObjMesh&>(obj).pAttr;
+                    if (attr.lightLevel()) {
+                        collector.actualDataref(attr.lightLevel().dataref());
+                    }
+                    if (attr.manipulator()) {
+                        attr.manipulator()->printObj(collector);
+                    }
+                    break;
+                }
+                case OBJ_LIGHT_CUSTOM:
+                    collector.actualDataref(static_cast<const ObjLightCustom&>(obj).dataRef());
+                    break;
+                case OBJ_LIGHT_SPILL_CUSTOM:
+                    collector.actualDataref(static_cast<const ObjLightSpillCust&>(obj).dataRef());
+                    break;
+                default: break;
+            }
+        }
+    }
+}
+
+bool ExportReferences::resolve(const DatarefRegistry * datarefs, const CommandRegistry * commands,
+                               const std::string & objectName) {
+    std::vector<std::string> missingDatarefs;
+    resolveIds(mDatarefs, [&](const std::uint64_t id) ->const std::string * {
+        const Dataref * drf = datarefs ? datarefs->find(id) : nullptr;
+        return drf ? &drf->mKey : nullptr;
+    }, missingDatarefs);
+
+    std::vector<std::string> missingCommands;
+    resolveIds(mCommands, [&](const std::uint64_t id) ->const std::string * {
+        const Command * cmd = commands ? commands->find(id) : nullptr;
+        return cmd ? &cmd->mKey : nullptr;
+    }, missingCommands);
+
+    if (!missingDatarefs.empty()) {
+        ULError << "The object <" << objectName << "> uses the datarefs ids which "
+                << (datarefs ? "aren't found in the datarefs file: " : "can't be resolved because the datarefs file isn't specified or loaded: ")
+                << joinSorted(missingDatarefs);
+    }
+    if (!missingCommands.empty()) {
+        ULError << "The object <" << objectName << "> uses the commands ids which "
+                << (commands ? "aren't found in the commands file: " : "can't be resolved because the commands file isn't specified or loaded: ")
+                << joinSorted(missingCommands);
+    }
+    return missingDatarefs.empty() && missingCommands.empty();
+}
+
+void ExportReferences::clear() {
+    mDatarefs.clear();
+    mCommands.clear();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "xpln/utils/DatarefRegistry.h"
+#include "xpln/utils/CommandRegistry.h"
+
+namespace xobj {
+
+class ExportPlan;
+class ObjWriteAnim;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details The datarefs and commands that are printed by the export plan.
+ *          They are collected and validated by one pass before printing,
+ *          so all the ids which can't be resolved are reported together
+ *          and the printing doesn't stop in the middle of the file.
+ */
+class ExportReferences {
+public:
+
+    //-------------------------------------------------------------------------
+
+    /*!
+     * \details Collects the datarefs and commands as they are specified in the objects.
+     *          The values are collected from the animations, lights, light level attributes and manipulators.
+     *          The animations which aren't printed, for example the ones removed by the keys reduction, are skipped.
+     * \param [in] plan
+     * \param [in] animWriter decides which animations are printed.
+     */
+    void collect(const ExportPlan & plan, const ObjWriteAnim & animWriter);
+
+    /*!
+     * \details Resolves the values which are ids.
+     *          All ids that can't be resolved are logged by one message.
+     * \param [in] datarefs can be nullptr if the datarefs aren't loaded.
+     * \param [in] commands can be nullptr if the commands aren't loaded.
+     * \param [in] objectName for the message.
+     * \return False if some id can't be resolved.
+     */
+    bool resolve(const DatarefRegistry * datarefs, const CommandRegistry * commands, const std::string & objectName);
+
+    void clear();
+
+    //-------------------------------------------------------------------------
+
+    /*!
+     * \details The actual datarefs after \link ExportReferences::resolve \endlink.
+     */
+    const std::unordered_set<std::string> & datarefs() const { return mDatarefs; }
+
+    /*!
+     * \details The actual commands after \link ExportReferences::resolve \endlink.
+     */
+    const std::unordered_set<std::string> & commands() const { return mCommands; }
+
+    //-------------------------------------------------------------------------
+
+private:
+
+    std::unordered_set<std::string> mDatarefs;
+    std::unordered_set<std::string> mCommands;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
@@ -32,6 +32,7 @@
 #include "io/ObjValidators.h"
 #include "common/AttributeNames.h"
 #include "converters/ObjAnimString.h"
+#include "algorithms/KeyframeAlg.h"
 
 namespace xobj {
 
@@ -107,7 +108,9 @@ bool ObjWriteAnim::printAnimationEnd(AbstractWriter & writer, const Transform &
 
 void ObjWriteAnim::printTrans(const AnimTransList & animTrans, const Transform & transform) const {
     std::string sep = mOptions->isEnabled(XOBJ_EXP_DEBUG) ? "   " : " ";
-    for (auto & a : animTrans) {
+    AnimTrans reduced;
+    for (auto & anim : animTrans) {
+        const AnimTrans & a = reducedKeys(anim, reduced);
         if (a.isAnimated() && checkParameters(a, std::string("Transform: ").append(transform.name()))) {
             if (a.pKeys.size() == 2) {
                 StringStream stream;
@@ -151,7 +154,9 @@ void ObjWriteAnim::printTrans(const AnimTransList & animTrans, const Transform &
 
 void ObjWriteAnim::printRotate(const AnimRotateList & animRot, const Transform & transform) const {
     std::string sep = mOptions->isEnabled(XOBJ_EXP_DEBUG) ? "   " : " ";
-    for (auto & a : animRot) {
+    AnimRotate reduced;
+    for (auto & anim : animRot) {
+        const AnimRotate & a = reducedKeys(anim, reduced);
         if (a.isAnimated() && checkParameters(a, std::string("Transform: ").append(transform.name()))) {
             if (a.pKeys.size() == 2) {
                 StringStream stream;
@@ -224,6 +229,44 @@ void ObjWriteAnim::printLoop(const float val) const {
     ++mStat->pAnimAttrCount;
 }
 
+bool ObjWriteAnim::isPrinted(const AnimTrans & anim) const {
+    if (!anim.isAnimated()) {
+        return false;
+    }
+    return !mOptions->isEnabled(XOBJ_EXP_REDUCE_KEYFRAMES) || !KeyframeAlg::isZero(anim, mPositionTolerance);
+}
+
+bool ObjWriteAnim::isPrinted(const AnimRotate & anim) const {
+    if (!anim.isAnimated()) {
+        return false;
+    }
+    return !mOptions->isEnabled(XOBJ_EXP_REDUCE_KEYFRAMES) || !KeyframeAlg::isZero(anim, mAngleTolerance);
+}
+
+const AnimTrans & ObjWriteAnim::reducedKeys(const AnimTrans & anim, AnimTrans & outReduced) const {
+    if (!mOptions->isEnabled(XOBJ_EXP_REDUCE_KEYFRAMES) || !anim.isAnimated()) {
+        return anim;
+    }
+    outReduced = anim;
+    mStat->pOptTransKeysRemovedCount += KeyframeAlg::reduce(outReduced, mPositionTolerance);
+    if (!outReduced.isAnimated()) {
+        ++mStat->pOptAnimRemovedCount;
+    }
+    return outReduced;
+}
+
+const AnimRotate & ObjWriteAnim::reducedKeys(const AnimRotate & anim, AnimRotate & outReduced) const {
+    if (!mOptions->isEnabled(XOBJ_EXP_REDUCE_KEYFRAMES) || !anim.isAnimated()) {
+        return anim;
+    }
+    outReduced = anim;
+    mStat->pOptRotateKeysRemovedCount += KeyframeAlg::reduce(outReduced, mAngleTolerance);
+    if (!outReduced.isAnimated()) {
+        ++mStat->pOptAnimRemovedCount;
+    }
+    return outReduced;
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
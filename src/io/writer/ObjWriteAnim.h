@@ -54,6 +54,26 @@ public:
 
     //-------------------------------------------------------------------------
 
+    /*!
+     * \details Tolerances of the keys simplification, see \link eExportOptions::XOBJ_EXP_REDUCE_KEYFRAMES \endlink.
+     */
+    void setKeyframesTolerance(const float position, const float degrees) {
+        mPositionTolerance = position;
+        mAngleTolerance = degrees;
+    }
+
+    /*!
+     * \details Checks whether the animation is printed,
+     *          it isn't printed if it doesn't have keys or its keys are removed by the reduction.
+     * \note Doesn't change the statistic.
+     */
+    bool isPrinted(const AnimTrans & anim) const;
+
+    /*!
+     * \copydoc ObjWriteAnim::isPrinted(const AnimTrans &) const
+     */
+    bool isPrinted(const AnimRotate & anim) const;
+
     bool printAnimationStart(AbstractWriter & writer, const Transform & transform);
     bool printAnimationEnd(AbstractWriter & writer, const Transform & transform);
 
@@ -67,11 +87,16 @@ private:
 
     void printLoop(float val) const;
 
+    const AnimTrans & reducedKeys(const AnimTrans & anim, AnimTrans & outReduced) const;
+    const AnimRotate & reducedKeys(const AnimRotate & anim, AnimRotate & outReduced) const;
+
     //-------------------------------------------------------------------------
 
     AbstractWriter * mWriter;
     IOStatistic * mStat;
     const ExportOptions * mOptions;
+    float mPositionTolerance = 0.0f;
+    float mAngleTolerance = 0.0f;
 
     //-------------------------------------------------------------------------
 
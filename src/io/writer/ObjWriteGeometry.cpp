@@ -28,12 +28,19 @@
 */
 
 #include <cassert>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+#include <limits>
 
 #include "ObjWriteGeometry.h"
 #include "converters/ObjString.h"
 #include "converters/StringStream.h"
+#include "converters/LineBuilder.h"
+#include "common/ParallelFor.h"
+#include "BlockWriter.h"
+#include "ExportPlan.h"
 
-#include "xpln/obj/ObjMain.h"
 #include "xpln/obj/ObjMesh.h"
 #include "xpln/obj/ObjLine.h"
 #include "xpln/obj/ObjLightPoint.h"
@@ -55,11 +62,7 @@ namespace xobj {
 ////////////////////////////////////* Constructors/Destructor */////////////////////////////////////
 /**************************************************************************************************/
 
-ObjWriteGeometry::ObjWriteGeometry(const ExportOptions * option, IOStatistic * outStat)
-    : mMeshFaceOffset(0),
-      mMeshVertexOffset(0),
-      mPointLightOffsetByObject(0) {
-
+ObjWriteGeometry::ObjWriteGeometry(const ExportOptions * option, IOStatistic * outStat) {
     assert(option);
     assert(outStat);
 
@@ -71,103 +74,172 @@ ObjWriteGeometry::ObjWriteGeometry(const ExportOptions * option, IOStatistic * o
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
-void ObjWriteGeometry::reset() {
-    mMeshVertexOffset = 0;
-    mMeshFaceOffset = 0;
-    mPointLightOffsetByObject = 0;
+void ObjWriteGeometry::printVertices(AbstractWriter & writer, const ExportPlan & plan) const {
+    VertexUnits units;
+    collectVertexUnits(units, plan, std::numeric_limits<std::size_t>::max());
+    for (const auto & unit : units) {
+        printVertexUnit(writer, plan, unit);
+    }
 }
 
-/**************************************************************************************************/
-///////////////////////////////////////////* Functions *////////////////////////////////////////////
-/**************************************************************************************************/
-
-void ObjWriteGeometry::printMeshVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const {
-    for (auto & objBase : transform.objList()) {
-        if (objBase->objType() == OBJ_MESH) {
-            const auto * mobj = static_cast<const ObjMesh*>(objBase.get());
+//-------------------------------------------------------------------------
 
-            if (mOptions->isEnabled(XOBJ_EXP_DEBUG)) {
-                writer.printLine(std::string("# ").append(mobj->objectName()));
-            }
+void ObjWriteGeometry::printVerticesParallel(AbstractWriter & writer, const ExportPlan & plan, const std::size_t threads) const {
+    // Vertices count of one formatting task,
+    // big enough for the threads synchronization to be cheap.
+    const std::size_t taskVertices = 32 * 1024;
+    // Vertices count of one unit, big meshes are split into chunks.
+    const std::size_t unitVertices = 32 * 1024;
+
+    VertexUnits units;
+    collectVertexUnits(units, plan, unitVertices);
+
+    //-------------------------------------------------------------------------
+    // tasks are ranges of units
+
+    std::vector<std::size_t> taskBegins;
+    std::size_t taskSize = taskVertices;
+    for (std::size_t i = 0; i < units.size(); ++i) {
+        if (taskSize >= taskVertices) {
+            taskBegins.emplace_back(i);
+            taskSize = 0;
+        }
+        taskSize += units[i].mEnd - units[i].mBegin;
+    }
+    taskBegins.emplace_back(units.size());
+
+    //-------------------------------------------------------------------------
+    // The tasks are processed by batches for limiting the memory,
+    // the blocks are reused so their memory is allocated only once.
+
+    const std::size_t tasksCount = taskBegins.size() - 1;
+    const std::size_t batchSize = std::min(actualThreadsCount(threads) * 4, tasksCount);
+    std::vector<std::unique_ptr<BlockWriter>> blocks;
+    blocks.reserve(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i) {
+        blocks.emplace_back(std::make_unique<BlockWriter>(writer));
+    }
 
-            for (const MeshVertex & v : mobj->pVertices) {
-                printObj(v, writer, mobj->pAttr.isTree());
+    for (std::size_t batch = 0; batch < tasksCount; batch += batchSize) {
+        const std::size_t count = std::min(batchSize, tasksCount - batch);
+        parallelFor(count, threads, [&](const std::size_t i) {
+            const std::size_t task = batch + i;
+            for (std::size_t u = taskBegins[task]; u < taskBegins[task + 1]; ++u) {
+                printVertexUnit(*blocks[i], plan, units[u]);
             }
+        });
+        for (std::size_t i = 0; i < count; ++i) {
+            blocks[i]->flushTo(writer);
         }
     }
 
-    for (Transform::TransformIndex i = 0; i < transform.childrenNum(); ++i) {
-        const auto * ch = dynamic_cast<const Transform*>(transform.childAt(i));
-        assert(ch);
-        if (ch) {
-            printMeshVerticiesRecursive(writer, *ch);
-        }
+    std::size_t blocksBytes = 0;
+    for (const auto & block : blocks) {
+        blocksBytes += block->block().capacity();
     }
+    mStat->pPeakBufferBytes = std::max(mStat->pPeakBufferBytes, blocksBytes);
 }
 
-/**************************************************************************************************/
-///////////////////////////////////////////* Functions *////////////////////////////////////////////
-/**************************************************************************************************/
-
-void ObjWriteGeometry::printMeshFaceRecursive(AbstractWriter & writer, const ObjMain & main) const {
-    std::stringstream stream;
-    stream.precision(PRECISION);
-    stream << std::fixed;
-
-    std::size_t idx = 0;
-    std::size_t offset = 0;
-    for (const auto & lod : main.lods()) {
-        writeMeshFaceRecursive(stream, lod->transform(), idx, offset);
+void ObjWriteGeometry::collectVertexUnits(VertexUnits & outUnits, const ExportPlan & plan, const std::size_t unitVertices) const {
+    const auto & meshes = plan.meshes();
+    const std::size_t lodMeshes = plan.hasMeshTable() ? meshes.size() : plan.lodMeshesCount();
+    if (plan.hasMeshTable()) {
+        // the draped vertices are in the same table.
+        addTableUnits(outUnits, plan, mOptions->isEnabled(XOBJ_EXP_DEBUG), unitVertices);
+    }
+    else if (plan.meshVerticesCount()) {
+        for (std::size_t i = 0; i < lodMeshes; ++i) {
+            addVertexUnits(outUnits, meshes[i], meshes[i]->verticesCount(), unitVertices);
+        }
+    }
+    if (plan.lineVerticesCount()) {
+        for (const auto * line : plan.lines()) {
+            addVertexUnits(outUnits, line, line->verticesList().size(), unitVertices);
+        }
+    }
+    for (const auto * light : plan.lightPoints()) {
+        addVertexUnits(outUnits, light, 1, unitVertices);
+    }
+    // draped
+    for (std::size_t i = lodMeshes; i < meshes.size(); ++i) {
+        addVertexUnits(outUnits, meshes[i], meshes[i]->verticesCount(), unitVertices);
     }
-    writeMeshFaceRecursive(stream, main.pDraped.transform(), idx, offset);
-    writer.printLine(stream.str());
 }
 
-void ObjWriteGeometry::writeMeshFaceRecursive(std::ostream & writer, const Transform & inNode, std::size_t & idx,
-                                              std::size_t & offset) const {
-    for (const auto & objBase : inNode.objList()) {
-        if (objBase->objType() != OBJ_MESH) {
-            continue;
+void ObjWriteGeometry::addTableUnits(VertexUnits & outUnits, const ExportPlan & plan,
+                                     const bool withMarks, const std::size_t unitVertices) {
+    const std::size_t count = plan.vertices().size();
+    std::vector<ExportPlan::TableMark> marks;
+    if (withMarks) {
+        plan.tableMarks(marks);
+    }
+    // The table is split at the marks, the mesh is set only for the first unit of its block.
+    std::size_t nextMark = 0;
+    std::size_t begin = 0;
+    while (begin < count) {
+        const ObjMesh * mesh = nullptr;
+        if (nextMark < marks.size() && marks[nextMark].mVertex == begin) {
+            mesh = marks[nextMark++].mMesh;
         }
+        std::size_t end = count - begin > unitVertices ? begin + unitVertices : count;
+        if (nextMark < marks.size()) {
+            end = std::min(end, marks[nextMark].mVertex);
+        }
+        outUnits.emplace_back(VertexUnit{mesh, begin, end, true});
+        begin = end;
+    }
+}
 
-        const auto * mobj = static_cast<const ObjMesh*>(objBase.get());
-        const ObjMesh::FaceList & faces = mobj->pFaces;
-
-        const std::size_t idxNum = faces.size() * 3U;
-        const std::size_t vEnd = mStat->pMeshFacesCount * 3U;
-
-        for (size_t currIdx = 0; currIdx < idxNum; ++currIdx) {
-            const std::size_t last = (idx % 10);
-            const std::size_t ost = (vEnd - idx);
-            ++idx;
+void ObjWriteGeometry::addVertexUnits(VertexUnits & outUnits, const ObjAbstract * obj,
+                                      const std::size_t count, const std::size_t unitVertices) {
+    // at least one unit for each object because of its name printing.
+    std::size_t begin = 0;
+    do {
+        const std::size_t end = count - begin > unitVertices ? begin + unitVertices : count;
+        outUnits.emplace_back(VertexUnit{obj, begin, end, false});
+        begin = end;
+    } while (begin < count);
+}
 
-            if (last == 0) {
-                ost < 10 ? writer << std::endl << MESH_IDX << " " : writer << std::endl << MESH_IDX10 << " ";
+void ObjWriteGeometry::printVertexUnit(AbstractWriter & writer, const ExportPlan & plan, const VertexUnit & unit) const {
+    if (unit.mTable) {
+        if (unit.mObj) {
+            writer.printLine(std::string("# ").append(unit.mObj->objectName()));
+        }
+        const auto & vertices = plan.vertices();
+        for (std::size_t i = unit.mBegin; i < unit.mEnd; ++i) {
+            printObj(vertices[i], writer, false);
+        }
+        return;
+    }
+    switch (unit.mObj->objType()) {
+        case OBJ_MESH: {
+            const auto * mobj = static_cast<const ObjMesh*>(unit.mObj);
+            if (unit.mBegin == 0 && mOptions->isEnabled(XOBJ_EXP_DEBUG)) {
+                writer.printLine(std::string("# ").append(mobj->objectName()));
             }
-            else if (last + ost < 10) {
-                writer << std::endl << MESH_IDX << " ";
+            const bool isTree = mobj->pAttr.isTree();
+            for (std::size_t i = unit.mBegin; i < unit.mEnd; ++i) {
+                printObj(mobj->vertices()[i], writer, isTree);
             }
-
-            const std::size_t modulo = currIdx % 3U;
-            const MeshFace & f = faces.at(currIdx / 3U);
-            switch (modulo) {
-                case 0: writer << (f.pV0 + offset) << " ";
-                    break;
-                case 2: writer << (f.pV2 + offset) << " ";
-                    break;
-                default: writer << (f.pV1 + offset) << " ";
-                    break;
+            break;
+        }
+        case OBJ_LINE: {
+            const auto * lobj = static_cast<const ObjLine*>(unit.mObj);
+            if (unit.mBegin == 0 && mOptions->isEnabled(XOBJ_EXP_DEBUG)) {
+                writer.printLine(std::string("# ").append(lobj->objectName()));
+            }
+            for (std::size_t i = unit.mBegin; i < unit.mEnd; ++i) {
+                printObj(lobj->verticesList()[i], writer);
             }
+            break;
         }
-        offset += mobj->pVertices.size();
-    }
-
-    for (Transform::TransformIndex i = 0; i < inNode.childrenNum(); ++i) {
-        const auto * ch = dynamic_cast<const Transform*>(inNode.childAt(i));
-        assert(ch);
-        if (ch) {
-            writeMeshFaceRecursive(writer, *ch, idx, offset);
+        case OBJ_LIGHT_POINT: {
+            const auto * lobj = static_cast<const ObjLightPoint*>(unit.mObj);
+            printObj(*lobj, writer, mOptions->isEnabled(XOBJ_EXP_MARK_LIGHT));
+            break;
         }
+        default: break;
     }
 }
 
@@ -175,96 +247,131 @@ void ObjWriteGeometry::writeMeshFaceRecursive(std::ostream & writer, const Trans
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
-void ObjWriteGeometry::printLineVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const {
-    for (auto & objBase : transform.objList()) {
-        if (objBase->objType() == OBJ_LINE) {
-            const auto lobj = static_cast<const ObjLine*>(objBase.get());
+/*!
+ * \details Prints indices by IDX10 groups and the rest by IDX lines.
+ *          The lines are collected into the chunk which is printed when it is full,
+ *          so the memory doesn't depend on the indices count.
+ */
+class ObjWriteGeometry::IdxWriter {
+public:
+
+    explicit IdxWriter(AbstractWriter & writer)
+        : mWriter(writer),
+          mChunk(new char[chunkSize() + maxLineSize()]) {}
+
+    IdxWriter(const IdxWriter &) = delete;
+    IdxWriter & operator=(const IdxWriter &) = delete;
+
+    void add(const std::size_t index) {
+        mGroup[mGroupSize++] = index;
+        if (mGroupSize == groupSize()) {
+            printLine(MESH_IDX10 " ", mGroup, groupSize());
+            mGroupSize = 0;
+        }
+    }
 
-            if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_DEBUG)) {
-                writer.printLine(std::string("# ").append(lobj->objectName()));
-            }
+    void finish() {
+        // the rest that can't make the full group is printed one index per line.
+        for (std::size_t i = 0; i < mGroupSize; ++i) {
+            printLine(MESH_IDX " ", mGroup + i, 1);
+        }
+        mGroupSize = 0;
+        flush();
+    }
 
-            for (const LineVertex & v : lobj->verticesList()) {
-                printObj(v, writer);
-            }
+private:
+
+    static constexpr std::size_t groupSize() { return 10; }
+    static constexpr std::size_t chunkSize() { return 64 * 1024; }
+    static constexpr std::size_t maxLineSize() { return 8 + groupSize() * NumberFormat::maxLength(); }
+
+    template<std::size_t N>
+    void printLine(const char (&keyword)[N], const std::size_t * indices, const std::size_t count) {
+        char * ptr = mChunk.get() + mChunkSize;
+        std::memcpy(ptr, keyword, N - 1);
+        ptr += N - 1;
+        for (std::size_t i = 0; i < count; ++i) {
+            ptr = NumberFormat::formatUInt(ptr, indices[i]);
+            *ptr++ = ' ';
+        }
+        *ptr++ = '\n';
+        mChunkSize = std::size_t(ptr - mChunk.get());
+        if (mChunkSize >= chunkSize()) {
+            flush();
         }
     }
 
-    for (Transform::TransformIndex i = 0; i < transform.childrenNum(); ++i) {
-        const auto * ch = dynamic_cast<const Transform*>(transform.childAt(i));
-        assert(ch);
-        if (ch) {
-            printLineVerticiesRecursive(writer, *dynamic_cast<const Transform*>(transform.childAt(i)));
+    void flush() {
+        if (mChunkSize == 0) {
+            return;
         }
+        // the last EOL is printed by the writer.
+        mChunk[mChunkSize - 1] = '\0';
+        mWriter.printLine(mChunk.get());
+        mChunkSize = 0;
     }
-}
+
+    AbstractWriter & mWriter;
+    std::unique_ptr<char[]> mChunk;
+    std::size_t mChunkSize = 0;
+    std::size_t mGroup[10];
+    std::size_t mGroupSize = 0;
+
+};
 
 //-------------------------------------------------------------------------
 
-void ObjWriteGeometry::printLightPointVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const {
-    for (auto & objBase : transform.objList()) {
-        if (objBase->objType() == OBJ_LIGHT_POINT) {
-            const auto lobj = static_cast<const ObjLightPoint*>(objBase.get());
-            printObj(*lobj, writer, mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_LIGHT));
+void ObjWriteGeometry::printMeshFaces(AbstractWriter & writer, const ExportPlan & plan) const {
+    writer.printEol();
+    IdxWriter out(writer);
+    if (plan.hasMeshTable()) {
+        for (const std::size_t index : plan.indices()) {
+            out.add(index);
         }
+        out.finish();
+        return;
     }
-
-    for (Transform::TransformIndex i = 0; i < transform.childrenNum(); ++i) {
-        const auto * ch = dynamic_cast<const Transform*>(transform.childAt(i));
-        assert(ch);
-        if (ch) {
-            printLightPointVerticiesRecursive(writer, *dynamic_cast<const Transform*>(transform.childAt(i)));
+    std::size_t offset = 0;
+    for (const auto * mobj : plan.meshes()) {
+        for (const MeshFace & f : mobj->pFaces) {
+            out.add(f.pV0 + offset);
+            out.add(f.pV1 + offset);
+            out.add(f.pV2 + offset);
         }
+        offset += mobj->verticesCount();
     }
+    out.finish();
 }
 
 /********************************************************************************************************/
 //////////////////////////////////////////////* Functions *///////////////////////////////////////////////
 /********************************************************************************************************/
 
-bool ObjWriteGeometry::printMeshObject(AbstractWriter & writer, const ObjAbstract & objBase) {
-    if (objBase.objType() == OBJ_MESH) {
-        const auto * mobj = static_cast<const ObjMesh*>(&objBase);
-        const std::size_t numface = mobj->pFaces.size();
-        std::stringstream stream;
-        stream.precision(PRECISION);
-        stream << std::fixed;
-
-        if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_MESH)) {
-            stream << MESH_TRIS << " " << (mMeshFaceOffset * 3) << " " << (numface * 3) << " ## " << mobj->objectName().data();
-        }
-        else {
-            stream << MESH_TRIS << " " << (mMeshFaceOffset * 3) << " " << (numface * 3);
-        }
-
-        writer.printLine(stream.str());
-        ++mStat->pMeshObjCount;
-        mMeshFaceOffset += numface;
-        return true;
+void ObjWriteGeometry::printMeshObject(AbstractWriter & writer, const ObjMesh & mesh,
+                                       const std::size_t faceOffset, const std::size_t faceCount) const {
+    LineBuilder out;
+    out.add(MESH_TRIS).add(' ').add(faceOffset * 3).add(' ').add(faceCount * 3);
+    if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_MESH)) {
+        out.add(" ## ").add(mesh.objectName());
     }
-    return false;
+
+    writer.printLine(out.c_str());
+    ++mStat->pMeshObjCount;
 }
 
 //-------------------------------------------------------------------------
 
-bool ObjWriteGeometry::printLightPointObject(AbstractWriter & writer, const ObjAbstract & objBase) {
-    if (objBase.objType() == OBJ_LIGHT_POINT) {
-        std::stringstream stream;
-        stream.precision(PRECISION);
-        stream << std::fixed;
-
-        stream << LIGHTS << " " << mPointLightOffsetByObject << " " << std::size_t(1);
-
-        if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_LIGHT)) {
-            stream << " ## " << objBase.objectName().c_str();
-        }
+void ObjWriteGeometry::printLightPointObject(AbstractWriter & writer, const ObjAbstract & objBase,
+                                             const std::size_t index, const std::size_t count) const {
+    LineBuilder out;
+    out.add(LIGHTS).add(' ').add(index).add(' ').add(count);
 
-        writer.printLine(stream.str());
-        ++mPointLightOffsetByObject;
-        ++mStat->pLightObjPointCount;
-        return true;
+    if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_LIGHT)) {
+        out.add(" ## ").add(objBase.objectName());
     }
-    return false;
+
+    writer.printLine(out.c_str());
+    ++mStat->pLightObjPointCount;
 }
 
 //-------------------------------------------------------------------------
@@ -304,28 +411,18 @@ printLightObject(AbstractWriter & writer, const ObjAbstract & objBase, const Tra
 
 //-------------------------------------------------------------------------
 
-bool ObjWriteGeometry::printLineObject(AbstractWriter & writer, const ObjAbstract & objBase) {
-    if (objBase.objType() == OBJ_LINE) {
-        // todo something wrong with this code wasn't it written? Seems like copy/paste from mesh.
-        const auto * lobj = static_cast<const ObjLine*>(&objBase);
-        const size_t numvert = lobj->verticesList().size();
-        std::stringstream stream;
-        stream.precision(PRECISION);
-        stream << std::fixed;
-
-        if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_LINE)) {
-            stream << LINES << " " << mMeshVertexOffset << " " << numvert << " ## " << lobj->objectName() << std::endl;
-        }
-        else {
-            stream << LINES << " " << mMeshVertexOffset << " " << numvert << std::endl;
-        }
-
-        writer.printLine(stream.str());
-        mMeshVertexOffset += numvert;
-        ++mStat->pLineObjCount;
-        return true;
+void ObjWriteGeometry::printLineObject(AbstractWriter & writer, const ObjLine & line,
+                                       const std::size_t vertexOffset, const std::size_t vertexCount) const {
+    // todo something wrong with this code wasn't it written? Seems like copy/paste from mesh.
+    LineBuilder out;
+    out.add(LINES).add(' ').add(vertexOffset).add(' ').add(vertexCount);
+    if (mOptions->isEnabled(eExportOptions::XOBJ_EXP_MARK_LINE)) {
+        out.add(" ## ").add(line.objectName());
     }
-    return false;
+    out.add('\n');
+
+    writer.printLine(out.c_str());
+    ++mStat->pLineObjCount;
 }
 
 //-------------------------------------------------------------------------
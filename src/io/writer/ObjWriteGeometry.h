@@ -30,7 +30,11 @@
 */
 
 #include <cstddef>
+#include <string>
+#include <vector>
+#include "xpln/Export.h"
 #include "AbstractWriter.h"
+#include "xpln/enums/eObjectType.h"
 
 namespace xobj {
 
@@ -48,7 +52,9 @@ class Counter;
 class Point3;
 class Transform;
 
-class ObjMain;
+class ObjMesh;
+class ObjLine;
+class ExportPlan;
 
 /**********************************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,40 +66,64 @@ class ObjMain;
 class ObjWriteGeometry {
 public:
 
-    ObjWriteGeometry(const ExportOptions * option, IOStatistic * outStat);
+    XpObjLib ObjWriteGeometry(const ExportOptions * option, IOStatistic * outStat);
 
     ObjWriteGeometry(const ObjWriteGeometry &) = delete;
     ObjWriteGeometry & operator =(const ObjWriteGeometry &) = delete;
 
     ~ObjWriteGeometry() = default;
 
-    void printMeshVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const;
-    void printLineVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const;
-    void printLightPointVerticiesRecursive(AbstractWriter & writer, const Transform & transform) const;
-    void printMeshFaceRecursive(AbstractWriter & writer, const ObjMain & main) const;
-
-    bool printMeshObject(AbstractWriter & writer, const ObjAbstract & objBase);
-    bool printLightPointObject(AbstractWriter & writer, const ObjAbstract & objBase);
+    /*!
+     * \details Prints VT, VLINE and VLIGHT sections of all the LODs and the draped geometry.
+     * \param [in] writer
+     * \param [in] plan
+     */
+    void printVertices(AbstractWriter & writer, const ExportPlan & plan) const;
+
+    /*!
+     * \details Prints VT, VLINE and VLIGHT sections of all the LODs and the draped geometry.
+     *          The text is formatted by several threads in blocks (big meshes are split into chunks),
+     *          the blocks are printed in the same order as the serial printing does,
+     *          so the result is the same.
+     * \param [in] writer
+     * \param [in] plan
+     * \param [in] threads 0 means hardware concurrency.
+     */
+    void printVerticesParallel(AbstractWriter & writer, const ExportPlan & plan, std::size_t threads) const;
+
+    XpObjLib void printMeshFaces(AbstractWriter & writer, const ExportPlan & plan) const;
+
+    void printMeshObject(AbstractWriter & writer, const ObjMesh & mesh, std::size_t faceOffset, std::size_t faceCount) const;
+    void printLightPointObject(AbstractWriter & writer, const ObjAbstract & objBase, std::size_t index, std::size_t count) const;
     bool printLightObject(AbstractWriter & writer, const ObjAbstract & objBase, const Transform & transform) const;
-    bool printLineObject(AbstractWriter & writer, const ObjAbstract & objBase);
+    void printLineObject(AbstractWriter & writer, const ObjLine & line, std::size_t vertexOffset, std::size_t vertexCount) const;
     bool printSmokeObject(AbstractWriter & writer, const ObjAbstract & objBase) const;
     bool printDummyObject(AbstractWriter & writer, const ObjAbstract & objBase) const;
 
-    void reset();
-
 private:
 
-    void writeMeshFaceRecursive(std::ostream & writer, const Transform & inNode, std::size_t & idx, std::size_t & offset) const;
+    class IdxWriter;
 
-    IOStatistic * mStat;
-    const ExportOptions * mOptions;
+    /*!
+     * \details Range of vertices of one object or of the global VT table.
+     *          For the table the object is the mesh whose debug mark is printed before the range or nullptr.
+     */
+    struct VertexUnit {
+        const ObjAbstract * mObj;
+        std::size_t mBegin;
+        std::size_t mEnd;
+        bool mTable;
+    };
 
-    // Mesh
-    std::size_t mMeshFaceOffset;
-    std::size_t mMeshVertexOffset;
+    typedef std::vector<VertexUnit> VertexUnits;
 
-    // Light
-    std::size_t mPointLightOffsetByObject;
+    void collectVertexUnits(VertexUnits & outUnits, const ExportPlan & plan, std::size_t unitVertices) const;
+    static void addTableUnits(VertexUnits & outUnits, const ExportPlan & plan, bool withMarks, std::size_t unitVertices);
+    static void addVertexUnits(VertexUnits & outUnits, const ObjAbstract * obj, std::size_t count, std::size_t unitVertices);
+    void printVertexUnit(AbstractWriter & writer, const ExportPlan & plan, const VertexUnit & unit) const;
+
+    IOStatistic * mStat;
+    const ExportOptions * mOptions;
 
 };
 
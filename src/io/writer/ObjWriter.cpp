@@ -27,6 +27,8 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <algorithm>
+
 #include "ObjWriter.h"
 #include "common/IInterrupterInternal.h"
 #include "xpln/obj/ObjMain.h"
@@ -34,6 +36,7 @@
 
 #include "xpln/Info.h"
 #include "Writer.h"
+#include "BlockWriter.h"
 #include "xpln/obj/ObjLine.h"
 #include "sts/utilities/Compare.h"
 #include "converters/ObjString.h"
@@ -43,6 +46,7 @@
 #include "common/Logger.h"
 #include "sts/string/StringUtils.h"
 #include "algorithms/LodsAlg.h"
+#include "common/PhaseTimer.h"
 
 namespace xobj {
 
@@ -72,8 +76,8 @@ void ObjWriter::reset() {
     mStatistic.reset();
     mWriteGlobAttr.reset();
     mWriteAttr.reset();
-    mObjWriteGeometry.reset();
     mObjWriteManip.reset();
+    mPlan.clear();
 }
 
 /**************************************************************************************************/
@@ -84,27 +88,44 @@ bool ObjWriter::writeFile(ObjMain * root, ExportContext & context, const TMatrix
     try {
         const IInterrupter & interrupt = *context.interrupter();
         reset(); // reset all data that needs to be recalculated
+        PhaseTimer totalTimer(mStatistic.pTimeTotal);
 
         if (root == nullptr || !checkParameters(*root, root->objectName())) {
             return false;
         }
 
         if (root->pExportOptions.isEnabled(XOBJ_EXP_DEBUG)) {
-            // todo sts::toMbString may work incorrectly.
-            ULMessage << "File: " << sts::toMbString(context.objFile());
+            if (context.outputCallback()) {
+                ULMessage << "File: <output>";
+            }
+            else {
+                // todo sts::toMbString may work incorrectly.
+                ULMessage << "File: " << sts::toMbString(context.objFile());
+            }
         }
 
         mMain = root;
         mExportOptions = root->pExportOptions;
+        mAnimationWritter.setKeyframesTolerance(context.keyframesPositionTolerance(), context.keyframesAngleTolerance());
 
         Writer writer;
-        if (!writer.openFile(context.objFile())) {
+        writer.setBufferSize(context.outputBufferSize());
+        if (context.outputCallback()) {
+            writer.openOutput(context.outputCallback());
+        }
+        else if (!writer.openFile(context.objFile())) {
             return false;
         }
-        if (!context.datarefsFile().empty() && !writer.loadDatarefs(context.datarefsFile())) {
+        if (context.datarefRegistry()) {
+            writer.setDatarefs(context.datarefRegistry());
+        }
+        else if (!context.datarefsFile().empty() && !writer.loadDatarefs(context.datarefsFile())) {
             return false;
         }
-        if (!context.commandsFile().empty() && !writer.loadCommands(context.commandsFile())) {
+        if (context.commandRegistry()) {
+            writer.setCommands(context.commandRegistry());
+        }
+        else if (!context.commandsFile().empty() && !writer.loadCommands(context.commandsFile())) {
             return false;
         }
         writer.spaceEnable(mExportOptions.isEnabled(XOBJ_EXP_MARK_TREE_HIERARCHY));
@@ -114,6 +135,7 @@ bool ObjWriter::writeFile(ObjMain * root, ExportContext & context, const TMatrix
             mMain->pDraped.setObjectName(mMain->objectName());
         }
 
+        PhaseTimer lodsTimer(mStatistic.pTimeLodsValidation);
         if (!LodsAlg::validate(mMain->lods(), mMain->objectName(), interrupt)) {
             return false;
         }
@@ -125,86 +147,108 @@ bool ObjWriter::writeFile(ObjMain * root, ExportContext & context, const TMatrix
         // }
 
         LodsAlg::removeWithoutObjects(mMain->lods(), interrupt);
-        LodsAlg::mergeIdenticalLods(mMain->lods(), interrupt);
+        if (mExportOptions.isEnabled(XOBJ_EXP_MERGE_IDENTICAL_GEOMETRY)) {
+            mStatistic.pOptMergedLodsCount += LodsAlg::mergeIdenticalLods(mMain->lods(), interrupt);
+        }
         if (!LodsAlg::sort(mMain->lods(), interrupt)) {
             return false;
         }
+        lodsTimer.stop();
         INTERRUPT_CHECK_WITH_RETURN_VAL(interrupt, false);
         //-------------------------------------------------------------------------
 
         if (mExportOptions.isEnabled(XOBJ_EXP_CHECK_INSTANCE)) {
+            PhaseTimer timer(mStatistic.pTimeInstancing);
             InstancingAlg::validateAndPrepare(*mMain);
         }
 
+        PhaseTimer preparingTimer(mStatistic.pTimePreparing);
         if (!ObjWritePreparer::prepare(*mMain)) {
             return false;
         }
+        preparingTimer.stop();
 
+        PhaseTimer transformationTimer(mStatistic.pTimeTransformation);
         ObjTransformation::correctExportTransform(*mMain, tm, mExportOptions.isEnabled(XOBJ_EXP_APPLY_LOD_TM));
-
-        //-------------------------------------------------------------------------
-        // calculate count
-        for (const auto & lod : mMain->lods()) {
-            calculateVerticiesAndFaces(lod->transform());
+        transformationTimer.stop();
+
+        PhaseTimer countingTimer(mStatistic.pTimeCounting);
+        mPlan.build(*mMain);
+        if (mExportOptions.isEnabled(XOBJ_EXP_OPTIMIZATION)) {
+            mPlan.optimizeMeshes(mExportOptions.isEnabled(XOBJ_EXP_MERGE_IDENTICAL_GEOMETRY));
+            // after the meshes optimization because it can remove the degenerate meshes.
+            mStatistic.pOptEmptyAnimCount += mPlan.removeEmptyAnimations();
+            mStatistic.pOptWeldedVerticesCount += mPlan.weldedVerticesCount();
+            mStatistic.pOptUnusedVerticesCount += mPlan.unusedVerticesCount();
+            mStatistic.pOptDegenerateFacesCount += mPlan.degenerateFacesCount();
+            mStatistic.pOptSharedFacesCount += mPlan.sharedFacesCount();
+        }
+        if (mExportOptions.isEnabled(XOBJ_EXP_OPTIMIZE_VERTEX_CACHE)) {
+            mPlan.optimizeVertexCache();
+            if (mPlan.meshFacesCount()) {
+                const auto faces = float(mPlan.meshFacesCount());
+                mStatistic.pOptAcmrBefore = float(mPlan.cacheMissesBefore()) / faces;
+                mStatistic.pOptAcmrAfter = float(mPlan.cacheMissesAfter()) / faces;
+            }
+        }
+        std::size_t trisAttrCountBefore = 0;
+        if (mExportOptions.isEnabled(XOBJ_EXP_REORDER_BY_ATTRIBUTES)) {
+            trisAttrCountBefore = countTrisAttributes(writer);
+            mPlan.reorderByAttributes();
         }
+        mStatistic.pMeshVerticesCount += mPlan.meshVerticesCount();
+        mStatistic.pMeshFacesCount += mPlan.meshFacesCount();
+        mStatistic.pLineVerticesCount += mPlan.lineVerticesCount();
+        mStatistic.pLightObjPointCount += mPlan.lightPoints().size();
+
+        ExportReferences references;
+        references.collect(mPlan, mAnimationWritter);
+        if (!references.resolve(writer.datarefs().get(), writer.commands().get(), mMain->objectName())) {
+            return false;
+        }
+        context.setUsedReferences(references.datarefs(), references.commands());
+        countingTimer.stop();
 
-        calculateVerticiesAndFaces(mMain->pDraped.transform());
+        if (context.isPreSizedOutputBuffer()) {
+            writer.setBufferSize(std::max(context.outputBufferSize(), estimateFileSize()));
+        }
 
         //-------------------------------------------------------------------------
         // print global
         printGlobalInformation(writer, *mMain);
 
-        // print mesh vertex 
-        if (mStatistic.pMeshVerticesCount) {
-            for (const auto & lod : mMain->lods()) {
-                mObjWriteGeometry.printMeshVerticiesRecursive(writer, lod->transform());
-            }
-        }
-
-        // print line vertex 
-        if (mStatistic.pLineVerticesCount) {
-            for (const auto & lod : mMain->lods()) {
-                mObjWriteGeometry.printLineVerticiesRecursive(writer, lod->transform());
-            }
+        PhaseTimer verticesTimer(mStatistic.pTimeVertices);
+        if (context.workerThreads() != 1) {
+            mObjWriteGeometry.printVerticesParallel(writer, mPlan, context.workerThreads());
         }
-
-        // print VLIGHT vertex 
-        if (mStatistic.pLightObjPointCount) {
-            for (const auto & lod : mMain->lods()) {
-                mObjWriteGeometry.printLightPointVerticiesRecursive(writer, lod->transform());
-            }
+        else {
+            mObjWriteGeometry.printVertices(writer, mPlan);
         }
-
-        // print draped
-        mObjWriteGeometry.printMeshVerticiesRecursive(writer, mMain->pDraped.transform());
+        verticesTimer.stop();
 
         writer.printEol();
 
         //-------------------------------------------------------------------------
         // print mesh faces 
+        PhaseTimer indicesTimer(mStatistic.pTimeIndices);
         if (mStatistic.pMeshVerticesCount) {
-            mObjWriteGeometry.printMeshFaceRecursive(writer, *mMain);
+            mObjWriteGeometry.printMeshFaces(writer, mPlan);
         }
+        indicesTimer.stop();
 
         writer.printEol();
         writer.printEol();
 
         // print animation and objects
-        for (const auto & currLod : mMain->lods()) {
-            if (currLod->transform().hasAnim()) {
-                ULError << currLod->objectName() << " - Lod can't be animated.";
-            }
-
-            printLOD(writer, *currLod, mMain->lods().size());
-            printObjects(writer, currLod->transform());
-            writer.printEol();
-        }
-
-        printObjects(writer, mMain->pDraped.transform());
-        writer.printEol();
+        PhaseTimer objectsTimer(mStatistic.pTimeObjects);
+        printObjects(writer);
+        objectsTimer.stop();
 
         mStatistic.pTrisManipCount += mObjWriteManip.count();
         mStatistic.pTrisAttrCount += mWriteAttr.count();
+        if (trisAttrCountBefore > mWriteAttr.count()) {
+            mStatistic.pOptTrisAttrAvoidedCount = trisAttrCountBefore - mWriteAttr.count();
+        }
 
         if (mMain->pAttr.isDebug()) {
             ++mStatistic.pGlobAttrCount;
@@ -213,8 +257,14 @@ bool ObjWriter::writeFile(ObjMain * root, ExportContext & context, const TMatrix
         }
 
         printSignature(writer, context.signature());
-        writer.closeFile();
+        if (!writer.closeFile()) {
+            return false;
+        }
+        mStatistic.pBytesWritten = writer.writtenBytes();
+        mStatistic.pPeakBufferBytes = std::max(mStatistic.pPeakBufferBytes, writer.peakBufferBytes());
+        totalTimer.stop();
         context.setStatistic(mStatistic);
+        mPlan.clear();
         return true;
     }
     catch (std::exception & e) {
@@ -265,27 +315,20 @@ void ObjWriter::printSignature(AbstractWriter & writer, const std::string & sign
 //////////////////////////////////////////////* Functions *///////////////////////////////////////////////
 /********************************************************************************************************/
 
-void ObjWriter::calculateVerticiesAndFaces(const Transform & parent) {
-    static const ObjMesh * mobj = nullptr;
-    static const ObjLine * lobj = nullptr;
-    for (auto & obj : parent.objList()) {
-        if (obj->objType() == OBJ_MESH) {
-            mobj = static_cast<const ObjMesh*>(obj.get());
-            mStatistic.pMeshVerticesCount += mobj->pVertices.size();
-            mStatistic.pMeshFacesCount += mobj->pFaces.size();
-        }
-        else if (obj->objType() == OBJ_LINE) {
-            lobj = static_cast<const ObjLine*>(obj.get());
-            mStatistic.pLineVerticesCount += lobj->verticesList().size();
-        }
-        else if (obj->objType() == OBJ_LIGHT_POINT) {
-            ++mStatistic.pLightObjPointCount;
-        }
-    }
-
-    for (Transform::TransformIndex i = 0; i < parent.childrenNum(); ++i) {
-        calculateVerticiesAndFaces(*dynamic_cast<const Transform*>(parent.childAt(i)));
-    }
+std::size_t ObjWriter::estimateFileSize() const {
+    // Approximate line lengths with the fixed precision,
+    // it is enough for the buffer to not be reallocated in most cases.
+    const std::size_t meshVertexBytes = 96;
+    const std::size_t lineVertexBytes = 64;
+    const std::size_t lightVertexBytes = 64;
+    const std::size_t indexBytes = 9;
+    const std::size_t objectsSectionBytes = 64 * 1024;
+
+    return mStatistic.pMeshVerticesCount * meshVertexBytes +
+           mStatistic.pLineVerticesCount * lineVertexBytes +
+           mStatistic.pLightObjPointCount * lightVertexBytes +
+           mStatistic.pMeshFacesCount * 3 * indexBytes +
+           objectsSectionBytes;
 }
 
 //-------------------------------------------------------------------------
@@ -309,65 +352,103 @@ void ObjWriter::printGlobalInformation(AbstractWriter & writer, const ObjMain &
 //////////////////////////////////////////////* Functions *///////////////////////////////////////////////
 /********************************************************************************************************/
 
-void ObjWriter::printObjects(AbstractWriter & writer, const Transform & parent) {
-
-    //-------------------------------------------------------------------------
-
-    mAnimationWritter.printAnimationStart(writer, parent);
-
-    //-------------------------------------------------------------------------
-
-    for (auto & objBase : parent.objList()) {
-        // order attr and manip is important.
-        mWriteAttr.write(&writer, objBase.get());
-        mObjWriteManip.write(&writer, objBase.get());
-
-        //--------------
-
-        mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataBefore());
-
-        if (mObjWriteGeometry.printMeshObject(writer, *objBase)) {
-            mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-            continue;
+void ObjWriter::printObjects(AbstractWriter & writer) {
+    const std::size_t lodsCount = mMain->lods().size();
+    const auto & records = mPlan.records();
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const ExportPlan::Record & record = records[i];
+        switch (record.mType) {
+            case ExportPlan::RECORD_LOD:
+                if (record.mTransform->hasAnim()) {
+                    ULError << record.mLod->objectName() << " - Lod can't be animated.";
+                }
+                printLOD(writer, *record.mLod, lodsCount);
+                break;
+            case ExportPlan::RECORD_ANIM_BEGIN:
+                mAnimationWritter.printAnimationStart(writer, *record.mTransform);
+                break;
+            case ExportPlan::RECORD_OBJECT: {
+                const std::size_t count = objectRecordsCount(i);
+                printObject(writer, record, records[i + count - 1]);
+                i += count - 1;
+                break;
+            }
+            case ExportPlan::RECORD_ANIM_END:
+                mAnimationWritter.printAnimationEnd(writer, *record.mTransform);
+                break;
+            case ExportPlan::RECORD_SECTION_END:
+                writer.printEol();
+                break;
         }
+    }
+}
 
-        if (mObjWriteGeometry.printLightObject(writer, *objBase, parent)) {
-            mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-            continue;
-        }
+std::size_t ObjWriter::objectRecordsCount(const std::size_t index) const {
+    if (!mExportOptions.isEnabled(XOBJ_EXP_COALESCE_RANGES)) {
+        return 1;
+    }
+    // the marked objects are printed one by one to keep their names.
+    const eObjectType type = mPlan.records()[index].mObject->objType();
+    if ((type == OBJ_MESH && mExportOptions.isEnabled(XOBJ_EXP_MARK_MESH)) ||
+        (type == OBJ_LIGHT_POINT && mExportOptions.isEnabled(XOBJ_EXP_MARK_LIGHT))) {
+        return 1;
+    }
+    return mPlan.rangeRecordsCount(index);
+}
 
-        if (mObjWriteGeometry.printSmokeObject(writer, *objBase)) {
-            mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-            continue;
-        }
+void ObjWriter::printObject(AbstractWriter & writer, const ExportPlan::Record & record, const ExportPlan::Record & last) {
+    const ObjAbstract & obj = *record.mObject;
+    // the records from the first to the last one are printed as one range.
+    const std::size_t rangeCount = last.mOffset + last.mCount - record.mOffset;
+    const std::size_t coalescedCount = std::size_t(&last - &record);
+
+    // order attr and manip is important.
+    mWriteAttr.write(&writer, &obj);
+    mObjWriteManip.write(&writer, &obj);
+
+    //--------------
+
+    mStatistic.pCustomLinesCount += printObjCustomData(writer, obj.dataBefore());
+
+    switch (obj.objType()) {
+        case OBJ_MESH:
+            mObjWriteGeometry.printMeshObject(writer, static_cast<const ObjMesh&>(obj), record.mOffset, rangeCount);
+            mStatistic.pMeshObjCount += coalescedCount;
+            mStatistic.pOptCoalescedObjCount += coalescedCount;
+            break;
+        case OBJ_LINE:
+            mObjWriteGeometry.printLineObject(writer, static_cast<const ObjLine&>(obj), record.mOffset, record.mCount);
+            break;
+        case OBJ_LIGHT_POINT:
+            mObjWriteGeometry.printLightPointObject(writer, obj, record.mOffset, rangeCount);
+            mStatistic.pLightObjPointCount += coalescedCount;
+            mStatistic.pOptCoalescedObjCount += coalescedCount;
+            break;
+        case OBJ_SMOKE:
+            mObjWriteGeometry.printSmokeObject(writer, obj);
+            break;
+        case OBJ_DUMMY:
+            mObjWriteGeometry.printDummyObject(writer, obj);
+            break;
+        default:
+            mObjWriteGeometry.printLightObject(writer, obj, *record.mTransform);
+            break;
+    }
 
-        if (mObjWriteGeometry.printDummyObject(writer, *objBase)) {
-            mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-            continue;
-        }
+    mStatistic.pCustomLinesCount += printObjCustomData(writer, obj.dataAfter());
+}
 
-        if (mObjWriteGeometry.printLineObject(writer, *objBase)) {
-            mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-            continue;
+std::size_t ObjWriter::countTrisAttributes(AbstractWriter & writer) const {
+    // the attributes are printed into the block which is cleared.
+    ObjWriteAttr attrWriter(nullptr);
+    BlockWriter block(writer);
+    for (const auto & record : mPlan.records()) {
+        if (record.mType == ExportPlan::RECORD_OBJECT) {
+            attrWriter.write(&block, record.mObject);
+            block.block().clear();
         }
-
-        mObjWriteGeometry.printLightPointObject(writer, *objBase);
-        mStatistic.pCustomLinesCount += printObjCustomData(writer, objBase->dataAfter());
-
-        //--------------
     }
-
-    //-------------------------------------------------------------------------
-
-    // print child
-    for (Transform::TransformIndex i = 0; i < parent.childrenNum(); ++i)
-        printObjects(writer, *dynamic_cast<const Transform*>(parent.childAt(i)));
-
-    //-------------------------------------------------------------------------
-
-    mAnimationWritter.printAnimationEnd(writer, parent);
-
-    //-------------------------------------------------------------------------
+    return attrWriter.count();
 }
 
 size_t ObjWriter::printObjCustomData(AbstractWriter & writer, const std::vector<std::string> & strings) {
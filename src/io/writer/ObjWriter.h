@@ -40,6 +40,8 @@
 #include "ObjWriteAnim.h"
 #include "ObjWriteGeometry.h"
 #include "ObjWriteManip.h"
+#include "ExportPlan.h"
+#include "ExportReferences.h"
 
 namespace xobj {
 
@@ -77,10 +79,14 @@ private:
     ObjWriteAttr mWriteAttr;
 
     ObjMain * mMain;
+    ExportPlan mPlan;
 
-    void calculateVerticiesAndFaces(const Transform & parent);
+    std::size_t estimateFileSize() const;
     void printGlobalInformation(AbstractWriter & writer, const ObjMain & objRoot);
-    void printObjects(AbstractWriter & writer, const Transform & parent);
+    void printObjects(AbstractWriter & writer);
+    std::size_t objectRecordsCount(std::size_t index) const;
+    void printObject(AbstractWriter & writer, const ExportPlan::Record & record, const ExportPlan::Record & last);
+    std::size_t countTrisAttributes(AbstractWriter & writer) const;
 
     static void printSignature(AbstractWriter & writer, const std::string & signature);
     void printLOD(AbstractWriter & writer, const ObjLodGroup & lod, size_t count) const;
@@ -27,6 +27,7 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <algorithm>
 #include "Writer.h"
 #include "common/Logger.h"
 #include "exceptions/defines.h"
@@ -41,7 +42,9 @@ namespace xobj {
 /**************************************************************************************************/
 
 Writer::~Writer() {
-    closeFile();
+    // the writer which isn't closed explicitly means the export is failed,
+    // so the buffered part of the object isn't written to the output.
+    discard();
 }
 
 /**************************************************************************************************/
@@ -49,21 +52,77 @@ Writer::~Writer() {
 /**************************************************************************************************/
 
 bool Writer::openFile(const Path & filePath) {
+    // The data is buffered by the writer itself,
+    // so the stream's buffer is disabled to avoid copying data twice.
+    // It must be done before opening.
+    mStream.rdbuf()->pubsetbuf(nullptr, 0);
     mStream.open(filePath, std::ios_base::out);
     if (!mStream) {
         // todo sts::toMbString may work incorrectly with unicode.
         ULError << " - File <" << sts::toMbString(filePath) << "> couldn't be created or written!";
         return false;
     }
-    mStream.precision(6);
-    mStream << std::fixed;
     return true;
 }
 
-void Writer::closeFile() {
-    if (mStream) {
+void Writer::openOutput(const ExportContext::OutputCallback & output) {
+    mOutput = output;
+    mOutputFailed = false;
+}
+
+bool Writer::closeFile() {
+    if (!mStream.is_open() && !mOutput) {
+        return true;
+    }
+    flush();
+    bool result = !mOutputFailed;
+    if (mStream.is_open()) {
+        result = result && static_cast<bool>(mStream);
+        mStream.close();
+    }
+    mOutput = nullptr;
+    if (!result) {
+        ULError << " - Data couldn't be written to the output!";
+    }
+    return result;
+}
+
+void Writer::discard() {
+    mBuffer.clear();
+    if (mStream.is_open()) {
         mStream.close();
     }
+    mOutput = nullptr;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+void Writer::setBufferSize(const std::size_t bytes) {
+    mBufferSize = bytes;
+    if (mBuffer.size() >= mBufferSize) {
+        flush();
+    }
+    mBuffer.reserve(mBufferSize);
+}
+
+void Writer::flush() {
+    if (mBuffer.empty()) {
+        return;
+    }
+    mWrittenBytes += mBuffer.size();
+    mPeakBufferBytes = std::max(mPeakBufferBytes, mBuffer.capacity());
+    if (mOutput) {
+        // the data is dropped after the first error, it is reported while closing.
+        if (!mOutputFailed && !mOutput(mBuffer.data(), mBuffer.size())) {
+            mOutputFailed = true;
+        }
+    }
+    else {
+        mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+    }
+    mBuffer.clear();
 }
 
 /**************************************************************************************************/
@@ -72,10 +131,11 @@ void Writer::closeFile() {
 
 void Writer::printLine(const char * msg) {
     if (msg) {
-        mStream << space().c_str() << msg << std::endl;
+        mBuffer.append(space()).append(msg);
     }
-    else {
-        mStream << std::endl;
+    mBuffer.push_back('\n');
+    if (mBuffer.size() >= mBufferSize) {
+        flush();
     }
 }
 
@@ -84,93 +144,67 @@ void Writer::printLine(const char * msg) {
 /**************************************************************************************************/
 
 bool Writer::loadDatarefs(const Path & filePath) {
-    std::ifstream file(filePath, std::ios_base::in);
-    if (!file) {
+    try {
+        mDatarefs = DatarefRegistry::cached(filePath);
+        return true;
+    }
+    catch (const std::exception & e) {
         // todo sts::toMbString may work incorrectly with unicode.
-        ULError << " - File <" << sts::toMbString(filePath) << "> couldn't be read!";
+        ULError << " - File <" << sts::toMbString(filePath) << "> couldn't be read: " << e.what();
         return false;
     }
-
-    const auto callback = [&](const Dataref & drf) ->bool {
-        if (drf.mId != Dataref::invalidId()) {
-            const auto iter = mDatarefs.find(drf.mId);
-            if (iter != mDatarefs.end()) {
-                // todo sts::toMbString may work incorrectly with unicode.
-                ULError << "File <" << sts::toMbString(filePath) << "> contains data with duplicated id: " << drf.mId;
-            }
-            else {
-                mDatarefs.emplace(drf.mId, drf);
-            }
-        }
-        return true;
-    };
-
-    return DatarefsFile::loadStream(file, callback);
 }
 
 bool Writer::loadCommands(const Path & filePath) {
-    std::ifstream file(filePath, std::ios_base::in);
-    if (!file) {
+    try {
+        mCommands = CommandRegistry::cached(filePath);
+        return true;
+    }
+    catch (const std::exception & e) {
         // todo sts::toMbString may work incorrectly with unicode.
-        ULError << " - File <" << sts::toMbString(filePath) << "> couldn't be read!";
+        ULError << " - File <" << sts::toMbString(filePath) << "> couldn't be read: " << e.what();
         return false;
     }
-
-    const auto callback = [&](const Command & cmd) ->bool {
-        if (cmd.mId != Dataref::invalidId()) {
-            const auto iter = mCommands.find(cmd.mId);
-            if (iter != mCommands.end()) {
-                // todo sts::toMbString may work incorrectly with unicode.
-                ULError << "File <" << sts::toMbString(filePath) << "> contains data with duplicated id: " << cmd.mId;
-            }
-            else {
-                mCommands.emplace(cmd.mId, cmd);
-            }
-        }
-        return true;
-    };
-
-    return CommandsFile::loadStream(file, callback);
 }
 
 /**************************************************************************************************/
 //////////////////////////////////////////* Functions */////////////////////////////////////////////
 /**************************************************************************************************/
 
-std::string Writer::actualDataref(const std::string & dataref) {
+const std::string & Writer::actualDataref(const std::string & dataref) {
     if (!Dataref::isKeyId(dataref)) {
         return dataref;
     }
-    if (dataref.empty()) {
+    if (!mDatarefs) {
         throw std::domain_error(ExcTxt("Dataref <"s.append(dataref)
                                     .append("> is considered as an id but datarefs file for extracting")
                                     .append(" the correct values isn't specified or loaded.")));
     }
-    const auto iter = mDatarefs.find(Dataref::keyToId(dataref));
-    if (iter == mDatarefs.end()) {
+    const Dataref * drf = mDatarefs->find(Dataref::keyToId(dataref));
+    if (!drf) {
         throw std::domain_error(ExcTxt("Dataref <"s.append(dataref)
                                     .append("> is considered as an id but datarefs file for extracting")
                                     .append(" the correct values doesn't contain necessary value.")));
     }
-    return iter->second.mKey;
+    return drf->mKey;
 }
 
-std::string Writer::actualCommand(const std::string & command) {
+const std::string & Writer::actualCommand(const std::string & command) {
     if (!Command::isKeyId(command)) {
         return command;
     }
-    if (command.empty()) {
+    if (!mCommands) {
         throw std::domain_error(ExcTxt("Command <"s.append(command)
                                     .append("> is considered as an id but commands file for extracting")
                                     .append(" the correct values isn't specified or loaded.")));
     }
-    const auto iter = mCommands.find(Command::keyToId(command));
-    if (iter == mCommands.end()) {
+    const Command * cmd = mCommands->find(Command::keyToId(command));
+    if (!cmd) {
         throw std::domain_error(ExcTxt("Command <"s.append(command)
                                     .append("> is considered as an id but commands file for extracting")
                                     .append(" the correct values doesn't contain necessary value.")));
     }
-    return iter->second.mKey;
+    return cmd->mKey;
 }
 
 /**************************************************************************************************/
@@ -30,11 +30,11 @@
 */
 
 #include <fstream>
-#include <map>
+#include <cstddef>
 #include "xpln/utils/Path.h"
 #include "AbstractWriter.h"
-#include "xpln/utils/DatarefsFile.h"
-#include "xpln/utils/CommandsFile.h"
+#include "xpln/utils/DatarefRegistry.h"
+#include "xpln/utils/CommandRegistry.h"
 #include "xpln/obj/ExportContext.h"
 
 namespace xobj {
@@ -58,11 +58,71 @@ public:
     //-------------------------------------------------------------------------
 
     bool openFile(const Path & filePath);
-    void closeFile();
 
+    /*!
+     * \details Opens the writer for printing into the callback instead of the file.
+     * \param [in] output receives the buffered data by chunks.
+     */
+    void openOutput(const ExportContext::OutputCallback & output);
+
+    /*!
+     * \details Flushes the buffer and closes the file or the output.
+     * \return False if the data couldn't be written otherwise true.
+     */
+    bool closeFile();
+
+    /*!
+     * \details Drops the buffered data and closes the file or the output without flushing.
+     *          The data which has already been flushed stays in the file or the output.
+     *          It is called by the destructor, so the writer which isn't closed by
+     *          \link Writer::closeFile \endlink doesn't write the rest of the failed object.
+     */
+    void discard();
+
+    /*!
+     * \details Sets size of the output buffer.
+     *          The lines are collected in the buffer and they are written to the file
+     *          or the output by one block when the buffer is full or the writer is closed.
+     *          It can be changed at any time, the current data is kept.
+     * \param [in] bytes 0 means each line is written to the file immediately.
+     */
+    void setBufferSize(std::size_t bytes);
+    std::size_t bufferSize() const { return mBufferSize; }
+
+    /*!
+     * \details Writes the buffered data to the file or the output.
+     */
+    void flush();
+
+    /*!
+     * \details Bytes written to the file or the output by flush().
+     */
+    std::size_t writtenBytes() const { return mWrittenBytes; }
+
+    /*!
+     * \details The biggest memory size of the output buffer.
+     */
+    std::size_t peakBufferBytes() const { return mPeakBufferBytes; }
+
+    /*!
+     * \details Loads the datarefs file through the process-wide cache,
+     *          see \link DatarefRegistry::cached \endlink.
+     * \return False if the file couldn't be loaded.
+     */
     bool loadDatarefs(const Path & filePath);
+
+    /*!
+     * \details Loads the commands file through the process-wide cache,
+     *          see \link CommandRegistry::cached \endlink.
+     * \return False if the file couldn't be loaded.
+     */
     bool loadCommands(const Path & filePath);
 
+    void setDatarefs(DatarefRegistry::Ptr datarefs) { mDatarefs = std::move(datarefs); }
+    void setCommands(CommandRegistry::Ptr commands) { mCommands = std::move(commands); }
+    const DatarefRegistry::Ptr & datarefs() const { return mDatarefs; }
+    const CommandRegistry::Ptr & commands() const { return mCommands; }
+
     //-------------------------------------------------------------------------
 
     /*! \copydoc AbstractWriter::printEol */
@@ -71,18 +131,24 @@ public:
     //-------------------------------------------------------------------------
 
     /*! \copydoc AbstractWriter::actualDataref */
-    std::string actualDataref(const std::string & dataref) override;
+    const std::string & actualDataref(const std::string & dataref) override;
 
     /*! \copydoc AbstractWriter::actualCommand */
-    std::string actualCommand(const std::string & command) override;
+    const std::string & actualCommand(const std::string & command) override;
 
     //-------------------------------------------------------------------------
 
 private:
 
-    std::map<std::uint64_t, Dataref> mDatarefs;
-    std::map<std::uint64_t, Command> mCommands;
+    DatarefRegistry::Ptr mDatarefs;
+    CommandRegistry::Ptr mCommands;
     std::ofstream mStream;
+    ExportContext::OutputCallback mOutput;
+    bool mOutputFailed = false;
+    std::string mBuffer;
+    std::size_t mBufferSize = 0;
+    std::size_t mWrittenBytes = 0;
+    std::size_t mPeakBufferBytes = 0;
 
 };
 
@@ -31,6 +31,7 @@
 #include "io/writer/ObjWriter.h"
 #include "io/reader/ObjReader.h"
 #include "io/reader/ObjReaderInterpreter.h"
+#include "algorithms/LodsAlg.h"
 
 namespace xobj {
 
@@ -46,6 +47,7 @@ bool ObjMain::exportObj(ExportContext & inOutContext) {
 
 bool ObjMain::importObj(ImportContext & inOutContext) {
     ObjReaderInterpreter interpreter(this, pMatrix, &inOutContext.statistic());
+    interpreter.setSharedMeshVertices(inOutContext.isSharedMeshVertices());
     return ObjReader::readFile(inOutContext, interpreter);
 }
 
@@ -53,6 +55,10 @@ bool ObjMain::importObj(ImportContext & inOutContext) {
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
+bool ObjMain::generateLods(const std::vector<LodLevel> & levels, const IInterrupter & interrupt) {
+    return LodsAlg::generate(mLods, levels, interrupt);
+}
+
 ObjLodGroup & ObjMain::addLod(ObjLodGroup * lod) {
     if (lod) {
         mLods.emplace_back(lod);
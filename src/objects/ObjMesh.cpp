@@ -27,6 +27,8 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <cassert>
+#include <utility>
 #include "xpln/obj/ObjMesh.h"
 #include "xpln/obj/Transform.h"
 
@@ -38,8 +40,12 @@ namespace xobj {
 
 ObjMesh::ObjMesh(const ObjMesh & copy)
     : ObjAbstract(copy),
+      pAttr(copy.pAttr),
       pVertices(copy.pVertices),
-      pFaces(copy.pFaces) {}
+      pFaces(copy.pFaces),
+      mSharedVertices(copy.mSharedVertices),
+      mSharedOffset(copy.mSharedOffset),
+      mSharedCount(copy.mSharedCount) {}
 
 ObjMesh::ObjMesh() {
     setObjectName("Obj Mesh");
@@ -51,17 +57,40 @@ ObjMesh::~ObjMesh() { }
 ///////////////////////////////////////////* Functions *////////////////////////////////////////////
 /**************************************************************************************************/
 
+void ObjMesh::setSharedVertices(SharedVertexList vertices, const std::size_t offset, const std::size_t count) {
+    assert(!vertices || offset + count <= vertices->size());
+    VertexList().swap(pVertices);
+    mSharedVertices = std::move(vertices);
+    mSharedOffset = mSharedVertices ? offset : 0;
+    mSharedCount = mSharedVertices ? count : 0;
+}
+
+void ObjMesh::detachVertices() {
+    if (mSharedVertices) {
+        const MeshVertex * begin = vertices();
+        VertexList own(begin, begin + mSharedCount);
+        mSharedVertices.reset();
+        mSharedOffset = 0;
+        mSharedCount = 0;
+        pVertices.swap(own);
+    }
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Functions *////////////////////////////////////////////
+/**************************************************************************************************/
+
 void ObjMesh::attach(const ObjMesh & otherMesh) {
+    detachVertices();
     const size_t vCount = pVertices.size();
-    for (auto & currVert : otherMesh.pVertices) {
-        pVertices.emplace_back(currVert);
-    }
+    pVertices.insert(pVertices.end(), otherMesh.vertices(), otherMesh.vertices() + otherMesh.verticesCount());
     for (auto & f : otherMesh.pFaces) {
         pFaces.emplace_back(f.pV0 + vCount, f.pV1 + vCount, f.pV2 + vCount);
     }
 }
 
 void ObjMesh::flipNormals() {
+    detachVertices();
     for (auto & vert : pVertices) {
         vert.pNormal *= -1.0;
     }
@@ -84,6 +113,12 @@ void ObjMesh::makeTwoSided() {
 /**************************************************************************************************/
 
 void ObjMesh::applyTransform(const TMatrix & tm, const bool useParity) {
+    // The identity matrix changes nothing,
+    // so the shared vertices aren't copied for it.
+    if (tm.isIdentity()) {
+        return;
+    }
+    detachVertices();
     for (auto & curr : pVertices) {
         tm.transformPoint(curr.pPosition);
         tm.transformVector(curr.pNormal);
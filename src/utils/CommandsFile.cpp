@@ -30,7 +30,10 @@
 #include "xpln/utils/CommandsFile.h"
 #include "exceptions/defines.h"
 #include "sts/string/StringUtils.h"
+#include "common/MappedFile.h"
+#include "TextParsing.h"
 #include <fstream>
+#include <iterator>
 #include <iomanip>
 #include <cctype>
 #include <algorithm>
@@ -60,20 +63,20 @@ std::uint64_t Command::keyToId(const std::string & key) {
 /**************************************************************************************************/
 
 bool CommandsFile::loadFile(const Path & filePath, const std::function<bool(const Command &)> & callback) {
+    Command data;
+    return mapFile(filePath, [&](const CommandRef & cmd) {
+        cmd.toCommand(data);
+        return callback(data);
+    });
+}
+
+bool CommandsFile::mapFile(const Path & filePath, const std::function<bool(const CommandRef &)> & callback) {
     using namespace std::string_literals;
-    std::ifstream file(filePath, std::iostream::in);
-    if (!file) {
+    MappedFile file;
+    if (!file.open(filePath)) {
         throw std::runtime_error(ExcTxt("can't open file <"s.append(sts::toMbString(filePath)).append(">")));
     }
-    try {
-        const auto res = loadStream(file, callback);
-        file.close();
-        return res;
-    }
-    catch (...) {
-        file.close();
-        throw;
-    }
+    return parse(file.data(), file.size(), callback);
 }
 
 void CommandsFile::saveFile(const Path & filePath, const std::function<bool(Command &)> & callback) {
@@ -97,58 +100,42 @@ void CommandsFile::saveFile(const Path & filePath, const std::function<bool(Comm
 /**************************************************************************************************/
 
 bool CommandsFile::loadStream(std::istream & input, const std::function<bool(const Command &)> & callback) {
-    std::string line;
+    const std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
     Command data;
+    return parse(content.data(), content.size(), [&](const CommandRef & cmd) {
+        cmd.toCommand(data);
+        return callback(data);
+    });
+}
 
-    const auto isBlank = [](const char ch) { return std::isblank(static_cast<unsigned char>(ch)); };
-    const auto isDigit = [](const char ch) { return std::isdigit(static_cast<unsigned char>(ch)); };
-
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            continue;
-        }
+bool CommandsFile::parse(const char * data, const std::size_t size, const std::function<bool(const CommandRef &)> & callback) {
+    const auto toRef = [](const char * first, const char * last) { return StringRef(first, static_cast<std::size_t>(last - first)); };
 
+    CommandRef cmd;
+    return forEachLine(data, data + size, [&](const char * lineBegin, const char * lineEnd) ->bool {
         // skip space
-        auto currPos = std::find_if_not(line.begin(), line.end(), isBlank);
-        if (currPos == line.end()) {
-            continue;
+        const char * currPos = std::find_if_not(lineBegin, lineEnd, isBlankChar);
+        if (currPos == lineEnd) {
+            return true;
         }
 
-        data.clear();
+        cmd = CommandRef();
         //------------------
-        if (isDigit(*currPos)) {
-            auto iter = std::find_if_not(currPos, line.end(), isDigit);
-            if (iter != line.end()) {
-                if (*iter == ':') {
-                    data.mId = Command::keyToId(std::string(currPos, iter));
-                    currPos = iter;
-                    ++currPos; // skip ':'
-                }
-
-                currPos = std::find_if_not(currPos, line.end(), isBlank);
-                iter = std::find_if(currPos, line.end(), isBlank);
-                data.mKey.assign(currPos, iter);
-                currPos = iter;
+        if (isDigitChar(*currPos)) {
+            const char * iter = std::find_if_not(currPos, lineEnd, isDigitChar);
+            if (iter != lineEnd && *iter == ':') {
+                cmd.mId = parseId(currPos, iter);
+                currPos = std::find_if_not(iter + 1, lineEnd, isBlankChar); // skip ':'
             }
-            else {
-                data.mKey.assign(currPos, iter);
-                currPos = iter;
-            }
-        }
-        else {
-            const auto iter = std::find_if(currPos, line.end(), isBlank);
-            data.mKey.assign(currPos, iter);
-            currPos = iter;
         }
+        const char * keyEnd = std::find_if(currPos, lineEnd, isBlankChar);
+        cmd.mKey = toRef(currPos, keyEnd);
         //------------------
-        currPos = std::find_if_not(currPos, line.end(), isBlank);
-        data.mDescription.assign(currPos, line.end());
+        currPos = std::find_if_not(keyEnd, lineEnd, isBlankChar);
+        cmd.mDescription = toRef(currPos, lineEnd);
 
-        if (!callback(data)) {
-            return false;
-        }
-    }
-    return true;
+        return callback(cmd);
+    });
 }
 
 void CommandsFile::saveStream(std::ostream & output, const std::function<bool(Command &)> & callback) {
@@ -30,8 +30,11 @@
 #include "xpln/utils/DatarefsFile.h"
 #include "exceptions/defines.h"
 #include "sts/string/StringUtils.h"
+#include "common/MappedFile.h"
+#include "TextParsing.h"
 #include <cassert>
 #include <fstream>
+#include <iterator>
 #include <iomanip>
 #include <cctype>
 #include <limits>
@@ -69,20 +72,21 @@ std::uint64_t Dataref::keyToId(const std::string & key) {
 /**************************************************************************************************/
 
 bool DatarefsFile::loadFile(const Path & filePath, const std::function<bool(const Dataref &)> & callback) {
+    assert(callback);
+    Dataref data;
+    return mapFile(filePath, [&](const DatarefRef & drf) {
+        drf.toDataref(data);
+        return callback(data);
+    });
+}
+
+bool DatarefsFile::mapFile(const Path & filePath, const std::function<bool(const DatarefRef &)> & callback) {
     using namespace std::string_literals;
-    std::ifstream file(filePath, std::iostream::in);
-    if (!file) {
+    MappedFile file;
+    if (!file.open(filePath)) {
         throw std::runtime_error(ExcTxt("can't open file <"s.append(sts::toMbString(filePath)).append(">")));
     }
-    try {
-        const auto res = loadStream(file, callback);
-        file.close();
-        return res;
-    }
-    catch (...) {
-        file.close();
-        throw;
-    }
+    return parse(file.data(), file.size(), callback);
 }
 
 void DatarefsFile::saveFile(const Path & filePath, const std::function<bool(Dataref &)> & callback) {
@@ -107,85 +111,73 @@ void DatarefsFile::saveFile(const Path & filePath, const std::function<bool(Data
 
 bool DatarefsFile::loadStream(std::istream & input, const std::function<bool(const Dataref &)> & callback) {
     assert(callback);
-    std::string line;
+    const std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
     Dataref data;
+    return parse(content.data(), content.size(), [&](const DatarefRef & drf) {
+        drf.toDataref(data);
+        return callback(data);
+    });
+}
 
-    const auto isDelimiter = [](const char ch) { return ch == '\t'; };
-    const auto isBlank = [](const char ch) { return std::isblank(static_cast<unsigned char>(ch)); };
-    const auto isDigit = [](const char ch) { return std::isdigit(static_cast<unsigned char>(ch)); };
-
+bool DatarefsFile::parse(const char * data, const std::size_t size, const std::function<bool(const DatarefRef &)> & callback) {
+    assert(callback);
     // remove firs line as the datarefs format
     // uses it for just an information.
-    if (! std::getline(input, line)) {
+    if (size == 0) {
         return false;
     }
+    const char * const end = data + size;
+    const char * begin = std::find(data, end, '\n');
+    begin = begin == end ? end : begin + 1;
 
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            continue;
-        }
+    const auto isDelimiter = [](const char ch) { return ch == '\t'; };
+    const auto toRef = [](const char * first, const char * last) { return StringRef(first, static_cast<std::size_t>(last - first)); };
 
+    DatarefRef drf;
+    return forEachLine(begin, end, [&](const char * lineBegin, const char * lineEnd) ->bool {
         // skip space
-        auto currPos = std::find_if_not(line.begin(), line.end(), isBlank);
-        if (currPos == line.end()) {
-            continue;
+        const char * currPos = std::find_if_not(lineBegin, lineEnd, isBlankChar);
+        if (currPos == lineEnd) {
+            return true;
         }
 
-        data.clear();
+        drf = DatarefRef();
         //------------------
-        if (isDigit(*currPos)) {
-            auto iter = std::find_if_not(currPos, line.end(), isDigit);
-            if (iter != line.end()) {
-                if (*iter == ':') {
-                    data.mId = Dataref::keyToId(std::string(currPos, iter));
-                    currPos = iter;
-                    ++currPos; // skip ':'
-                }
-
-                currPos = std::find_if_not(currPos, line.end(), isBlank);
-                iter = std::find_if(currPos, line.end(), isBlank);
-                data.mKey.assign(currPos, iter);
-                currPos = iter;
+        if (isDigitChar(*currPos)) {
+            const char * iter = std::find_if_not(currPos, lineEnd, isDigitChar);
+            if (iter != lineEnd && *iter == ':') {
+                drf.mId = parseId(currPos, iter);
+                currPos = std::find_if_not(iter + 1, lineEnd, isBlankChar); // skip ':'
             }
-            else {
-                data.mKey.assign(currPos, iter);
-                currPos = iter;
-            }
-        }
-        else {
-            const auto iter = std::find_if(currPos, line.end(), isBlank);
-            data.mKey.assign(currPos, iter);
-            currPos = iter;
         }
+        const char * keyEnd = std::find_if(currPos, lineEnd, isBlankChar);
+        drf.mKey = toRef(currPos, keyEnd);
+        currPos = keyEnd;
         //------------------
-        currPos = std::find_if(currPos, line.end(), isDelimiter);
-        currPos = std::find_if_not(currPos, line.end(), isDelimiter); // remove delimiters
+        currPos = std::find_if(currPos, lineEnd, isDelimiter);
+        currPos = std::find_if_not(currPos, lineEnd, isDelimiter); // remove delimiters
 
-        auto nextDelimiter = std::find_if(currPos, line.end(), isDelimiter);
-        data.mValueType.assign(currPos, nextDelimiter);
+        const char * nextDelimiter = std::find_if(currPos, lineEnd, isDelimiter);
+        drf.mValueType = toRef(currPos, nextDelimiter);
         currPos = nextDelimiter;
         //------------------
-        currPos = std::find_if_not(currPos, line.end(), isDelimiter); // remove delimiters
+        currPos = std::find_if_not(currPos, lineEnd, isDelimiter); // remove delimiters
 
-        nextDelimiter = std::find_if(currPos, line.end(), isDelimiter);
-        const std::string tmp(currPos, nextDelimiter);
-        data.mWritable = !tmp.empty() && tmp.front() == 'y';
+        nextDelimiter = std::find_if(currPos, lineEnd, isDelimiter);
+        drf.mWritable = currPos != nextDelimiter && *currPos == 'y';
         currPos = nextDelimiter;
         //------------------
-        currPos = std::find_if_not(currPos, line.end(), isDelimiter); // remove delimiters
+        currPos = std::find_if_not(currPos, lineEnd, isDelimiter); // remove delimiters
 
-        nextDelimiter = std::find_if(currPos, line.end(), isDelimiter);
-        data.mValueUnits.assign(currPos, nextDelimiter);
+        nextDelimiter = std::find_if(currPos, lineEnd, isDelimiter);
+        drf.mValueUnits = toRef(currPos, nextDelimiter);
         currPos = nextDelimiter;
         //------------------
-        currPos = std::find_if_not(currPos, line.end(), isDelimiter); // remove delimiters
-        data.mDescription.assign(currPos, line.end());
+        currPos = std::find_if_not(currPos, lineEnd, isDelimiter); // remove delimiters
+        drf.mDescription = toRef(currPos, lineEnd);
         //------------------
-        if (!callback(data)) {
-            return false;
-        }
-    }
-    return true;
+        return callback(drf);
+    });
 }
 
 void DatarefsFile::saveStream(std::ostream & output, const std::function<bool(Dataref &)> & callback) {
@@ -0,0 +1,136 @@
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include "xpln/utils/IdRegistry.h"
+#include <istream>
+#include <iterator>
+#include <string>
+#include "xpln/utils/DatarefsFile.h"
+#include "xpln/utils/CommandsFile.h"
+#include "RegistryCache.h"
+#include "common/Logger.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Static area *////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details The file type and the entry conversion of each registry.
+ */
+template<typename Entry>
+struct IdRegistryTraits;
+
+template<>
+struct IdRegistryTraits<Dataref> {
+    typedef DatarefsFile File;
+    static const char * name() { return "Datarefs"; }
+    static void copy(const DatarefRef & ref, Dataref & outEntry) { ref.toDataref(outEntry); }
+};
+
+template<>
+struct IdRegistryTraits<Command> {
+    typedef CommandsFile File;
+    static const char * name() { return "Commands"; }
+    static void copy(const CommandRef & ref, Command & outEntry) { ref.toCommand(outEntry); }
+};
+
+/*!
+ * \details Only the entries with id are copied from the parsed data.
+ *          The first entry is kept if the id is duplicated.
+ */
+template<typename Entry>
+static auto entryCollector(std::unordered_map<std::uint64_t, Entry> & outEntries) {
+    return [&outEntries](const auto & ref) {
+        if (ref.isIdValid()) {
+            const auto res = outEntries.emplace(ref.mId, Entry());
+            if (res.second) {
+                IdRegistryTraits<Entry>::copy(ref, res.first->second);
+            }
+            else {
+                ULError << IdRegistryTraits<Entry>::name() << " contain data with duplicated id: " << ref.mId;
+            }
+        }
+        return true;
+    };
+}
+
+template<typename Entry>
+static RegistryCache<IdRegistry<Entry>> & registryCache() {
+    static RegistryCache<IdRegistry<Entry>> cache;
+    return cache;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+template<typename Entry>
+typename IdRegistry<Entry>::Ptr IdRegistry<Entry>::loadFile(const Path & filePath) {
+    std::shared_ptr<IdRegistry> registry(new IdRegistry());
+    IdRegistryTraits<Entry>::File::mapFile(filePath, entryCollector(registry->mEntries));
+    return registry;
+}
+
+template<typename Entry>
+typename IdRegistry<Entry>::Ptr IdRegistry<Entry>::loadStream(std::istream & input) {
+    std::shared_ptr<IdRegistry> registry(new IdRegistry());
+    const std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    IdRegistryTraits<Entry>::File::parse(content.data(), content.size(), entryCollector(registry->mEntries));
+    return registry;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+template<typename Entry>
+typename IdRegistry<Entry>::Ptr IdRegistry<Entry>::cached(const Path & filePath, const bool revalidate) {
+    return registryCache<Entry>().get(filePath, revalidate, &IdRegistry::loadFile);
+}
+
+template<typename Entry>
+void IdRegistry<Entry>::clearCache() {
+    registryCache<Entry>().clear();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+template class IdRegistry<Dataref>;
+template class IdRegistry<Command>;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+}
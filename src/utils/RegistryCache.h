@@ -0,0 +1,187 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "xpln/utils/Path.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Modification time and size of a file.
+ *          It is used for detecting that a cached file was changed.
+ */
+struct FileStamp {
+
+    bool pExists = false;
+    std::int64_t pTime = 0;
+    std::uint64_t pSize = 0;
+
+    bool operator==(const FileStamp & other) const {
+        return pExists == other.pExists && pTime == other.pTime && pSize == other.pSize;
+    }
+
+    bool operator!=(const FileStamp & other) const {
+        return !(*this == other);
+    }
+
+    static FileStamp read(const Path & filePath) {
+        FileStamp out;
+#ifdef _MSC_VER
+        struct _stat64 st;
+        if (_wstat64(filePath.c_str(), &st) == 0) {
+#else
+        struct stat st;
+        if (stat(filePath.c_str(), &st) == 0) {
+#endif
+            out.pExists = true;
+            out.pTime = static_cast<std::int64_t>(st.st_mtime);
+            out.pSize = static_cast<std::uint64_t>(st.st_size);
+        }
+        return out;
+    }
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Process-wide cache of the registries that are loaded from files.
+ *          The registries are immutable so they are shared between the threads.
+ *          The lock is held only for the cache lookup, a file is loaded outside of it
+ *          and the concurrent requests for the same file wait for that loading,
+ *          so the file is parsed only once and the requests for other files aren't blocked.
+ *          A failed loading isn't cached, the next request tries again.
+ *          The cache keeps maxItems() last used files, the least recently used one is evicted
+ *          when a new file is added. The evicted registries stay valid for their users.
+ */
+template<typename Registry>
+class RegistryCache {
+public:
+
+    typedef std::shared_ptr<const Registry> Ptr;
+
+    static constexpr std::size_t maxItems() { return 16; }
+
+    template<typename Loader>
+    Ptr get(const Path & filePath, const bool revalidate, Loader loader) {
+        // The stamp is taken before loading,
+        // so a file that is changed while loading is reloaded next time.
+        const FileStamp stamp = FileStamp::read(filePath);
+        std::promise<Ptr> promise;
+        std::shared_future<Ptr> future;
+        std::uint64_t loading = 0;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mTick;
+            auto iter = mItems.find(filePath);
+            if (iter != mItems.end() && (!revalidate || iter->second.mStamp == stamp)) {
+                iter->second.mLastUse = mTick;
+                future = iter->second.mRegistry;
+            }
+            else {
+                if (iter == mItems.end() && mItems.size() >= maxItems()) {
+                    evictLeastUsed();
+                }
+                future = promise.get_future().share();
+                loading = mTick;
+                mItems[filePath] = Item{stamp, future, loading, mTick};
+            }
+        }
+
+        if (loading != 0) {
+            try {
+                promise.set_value(loader(filePath));
+            }
+            catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    const auto iter = mItems.find(filePath);
+                    // the item may be replaced by a newer loading.
+                    if (iter != mItems.end() && iter->second.mLoading == loading) {
+                        mItems.erase(iter);
+                    }
+                }
+                promise.set_exception(std::current_exception());
+            }
+        }
+        return future.get();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mItems.clear();
+    }
+
+private:
+
+    struct Item {
+        FileStamp mStamp;
+        std::shared_future<Ptr> mRegistry;
+        std::uint64_t mLoading; //!< identifies the loading which made the item.
+        std::uint64_t mLastUse;
+    };
+
+    void evictLeastUsed() {
+        auto least = mItems.begin();
+        for (auto iter = mItems.begin(); iter != mItems.end(); ++iter) {
+            if (iter->second.mLastUse < least->second.mLastUse) {
+                least = iter;
+            }
+        }
+        if (least != mItems.end()) {
+            mItems.erase(least);
+        }
+    }
+
+    std::mutex mMutex;
+    std::map<Path, Item> mItems;
+    std::uint64_t mTick = 0;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}
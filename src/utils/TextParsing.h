@@ -0,0 +1,105 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "exceptions/defines.h"
+
+namespace xobj {
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * Helpers for the datarefs and commands parsers.
+ * They work with the raw character ranges so the lines are not copied.
+ */
+
+inline bool isBlankChar(const char ch) {
+    return std::isblank(static_cast<unsigned char>(ch)) != 0;
+}
+
+inline bool isDigitChar(const char ch) {
+    return std::isdigit(static_cast<unsigned char>(ch)) != 0;
+}
+
+/*!
+ * \details Converts the digits to id.
+ * \pre The range contains only digits.
+ * \exception std::out_of_range if the value doesn't fit to the id.
+ */
+inline std::uint64_t parseId(const char * begin, const char * end) {
+    const std::uint64_t maxVal = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t out = 0;
+    for (const char * iter = begin; iter != end; ++iter) {
+        const auto digit = static_cast<std::uint64_t>(*iter - '0');
+        if (out > (maxVal - digit) / 10) {
+            throw std::out_of_range(ExcTxt(std::string("id <").append(begin, end).append("> is too big")));
+        }
+        out = out * 10 + digit;
+    }
+    return out;
+}
+
+/*!
+ * \details Calls the function for each line of the data like std::getline does.
+ *          The line doesn't contain the '\n' symbol and the '\r' before it,
+ *          so the files with the windows line endings are read the same way on all platforms.
+ * \param [in] begin
+ * \param [in] end
+ * \param [in] fn bool(const char * lineBegin, const char * lineEnd), return false for stopping.
+ * \return False if the function returned false otherwise true.
+ */
+template<typename Fn>
+bool forEachLine(const char * begin, const char * end, Fn fn) {
+    while (begin != end) {
+        const char * lineEnd = std::find(begin, end, '\n');
+        const char * next = lineEnd == end ? end : lineEnd + 1;
+        if (lineEnd != begin && *(lineEnd - 1) == '\r') {
+            --lineEnd;
+        }
+        if (!fn(begin, lineEnd)) {
+            return false;
+        }
+        begin = next;
+    }
+    return true;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+}